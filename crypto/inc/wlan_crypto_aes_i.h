@@ -189,6 +189,8 @@ uint8_t *wlan_crypto_wep_decrypt(const uint8_t *key, uint16_t key_len,
 void wlan_crypto_wep_crypt(uint8_t *key, uint8_t *buf, size_t plen);
 
 uint32_t wlan_crypto_crc32(const uint8_t *frame, size_t frame_len);
+uint32_t wlan_crypto_crc32_update(uint32_t crc, const uint8_t *buf,
+				  size_t len);
 
 int wlan_crypto_aes_gcm_ae(const uint8_t *key, size_t key_len,
 			const uint8_t *iv, size_t iv_len,
@@ -215,6 +217,17 @@ int wlan_crypto_aes_ccm_ad(const uint8_t *key, size_t key_len,
 			size_t crypt_len, const uint8_t *aad, size_t aad_len,
 			const uint8_t *auth, uint8_t *plain);
 
+int wlan_crypto_aes_ccm_ae_ctx(void *aes, const uint8_t *nonce, size_t M,
+			       const uint8_t *plain, size_t plain_len,
+			       const uint8_t *aad, size_t aad_len,
+			       uint8_t *crypt, uint8_t *auth);
+
+int wlan_crypto_aes_ccm_ad_ctx(void *aes, const uint8_t *nonce, size_t M,
+			       const uint8_t *crypt, size_t crypt_len,
+			       const uint8_t *aad, size_t aad_len,
+			       const uint8_t *auth, uint8_t *plain);
+
+int wlan_crypto_aes_encrypt_setup(void *ctx, const uint8_t *key, size_t len);
 void *wlan_crypto_aes_encrypt_init(const uint8_t *key, size_t len);
 void wlan_crypto_aes_encrypt(void *ctx, const uint8_t *plain, uint8_t *crypt);
 void wlan_crypto_aes_encrypt_deinit(void *ctx);
@@ -95,26 +95,33 @@ static void aes_ccm_encr_start(size_t L, const uint8_t *nonce, uint8_t *a)
 }
 
 
+/*
+ * The keystream is generated into a local block and only @len bytes of
+ * @out are written, each after the matching @in block has been read, so
+ * @out may be the same buffer as @in or start before it.
+ */
 static void aes_ccm_encr(void *aes, size_t L, const uint8_t *in, size_t len,
 			uint8_t *out, uint8_t *a){
 	size_t last = len % AES_BLOCK_SIZE;
 	size_t i;
+	uint8_t s[AES_BLOCK_SIZE];
 
 	/* crypt = msg XOR (S_1 | S_2 | ... | S_n) */
 	for (i = 1; i <= len / AES_BLOCK_SIZE; i++) {
 		wlan_crypto_put_be16(&a[AES_BLOCK_SIZE - 2], i);
 		/* S_i = E(K, A_i) */
-		wlan_crypto_aes_encrypt(aes, a, out);
-		xor_aes_block(out, in);
+		wlan_crypto_aes_encrypt(aes, a, s);
+		xor_aes_block(s, in);
+		qdf_mem_copy(out, s, AES_BLOCK_SIZE);
 		out += AES_BLOCK_SIZE;
 		in += AES_BLOCK_SIZE;
 	}
 	if (last) {
 		wlan_crypto_put_be16(&a[AES_BLOCK_SIZE - 2], i);
-		wlan_crypto_aes_encrypt(aes, a, out);
+		wlan_crypto_aes_encrypt(aes, a, s);
 		/* XOR zero-padded last block */
 		for (i = 0; i < last; i++)
-			*out++ ^= *in++;
+			*out++ = *in++ ^ s[i];
 	}
 }
 
@@ -149,15 +156,97 @@ static void aes_ccm_decr_auth(void *aes, size_t M, uint8_t *a,
 }
 
 
+/**
+ * wlan_crypto_aes_ccm_ae_ctx() - CCM encrypt with an expanded AES key
+ * @aes: key schedule from wlan_crypto_aes_encrypt_init()/_setup()
+ * @nonce: 13 byte nonce
+ * @M: MIC length
+ * @plain: plaintext
+ * @plain_len: length of @plain
+ * @aad: additional authenticated data, at most 30 bytes
+ * @aad_len: length of @aad
+ * @crypt: ciphertext output, may be the same buffer as @plain
+ * @auth: MIC output
+ *
+ * Return: 0 on success, -1 on invalid arguments
+ */
+int wlan_crypto_aes_ccm_ae_ctx(void *aes, const uint8_t *nonce, size_t M,
+			       const uint8_t *plain, size_t plain_len,
+			       const uint8_t *aad, size_t aad_len,
+			       uint8_t *crypt, uint8_t *auth)
+{
+	const size_t L = 2;
+	uint8_t x[AES_BLOCK_SIZE], a[AES_BLOCK_SIZE];
+
+	if (aad_len > 30 || M > AES_BLOCK_SIZE)
+		return -1;
+
+	aes_ccm_auth_start(aes, M, L, nonce, aad, aad_len, plain_len, x);
+	aes_ccm_auth(aes, plain, plain_len, x);
+
+	/* Encryption */
+	aes_ccm_encr_start(L, nonce, a);
+	aes_ccm_encr(aes, L, plain, plain_len, crypt, a);
+	aes_ccm_encr_auth(aes, M, x, a, auth);
+
+	return 0;
+}
+
+
+/**
+ * wlan_crypto_aes_ccm_ad_ctx() - CCM decrypt with an expanded AES key
+ * @aes: key schedule from wlan_crypto_aes_encrypt_init()/_setup()
+ * @nonce: 13 byte nonce
+ * @M: MIC length
+ * @crypt: ciphertext
+ * @crypt_len: length of @crypt
+ * @aad: additional authenticated data, at most 30 bytes
+ * @aad_len: length of @aad
+ * @auth: received MIC
+ * @plain: plaintext output, may be @crypt or start before it
+ *
+ * @plain is written even when the MIC does not match.
+ *
+ * Return: 0 on success, -1 on invalid arguments or MIC mismatch
+ */
+int wlan_crypto_aes_ccm_ad_ctx(void *aes, const uint8_t *nonce, size_t M,
+			       const uint8_t *crypt, size_t crypt_len,
+			       const uint8_t *aad, size_t aad_len,
+			       const uint8_t *auth, uint8_t *plain)
+{
+	const size_t L = 2;
+	uint8_t x[AES_BLOCK_SIZE], a[AES_BLOCK_SIZE];
+	uint8_t t[AES_BLOCK_SIZE];
+
+	if (aad_len > 30 || M > AES_BLOCK_SIZE)
+		return -1;
+
+	/* Decryption */
+	aes_ccm_encr_start(L, nonce, a);
+	aes_ccm_decr_auth(aes, M, a, auth, t);
+
+	/* plaintext = msg XOR (S_1 | S_2 | ... | S_n) */
+	aes_ccm_encr(aes, L, crypt, crypt_len, plain, a);
+
+	aes_ccm_auth_start(aes, M, L, nonce, aad, aad_len, crypt_len, x);
+	aes_ccm_auth(aes, plain, crypt_len, x);
+
+	if (qdf_mem_cmp(x, t, M) != 0) {
+		wpa_printf(MSG_EXCESSIVE, "CCM: Auth mismatch");
+		return -1;
+	}
+
+	return 0;
+}
+
+
 /* AES-CCM with fixed L=2 and aad_len <= 30 assumption */
 int wlan_crypto_aes_ccm_ae(const uint8_t *key, size_t key_len,
 				const uint8_t *nonce, size_t M,
 				const uint8_t *plain, size_t plain_len,
 				const uint8_t *aad, size_t aad_len,
 				uint8_t *crypt, uint8_t *auth){
-	const size_t L = 2;
 	void *aes;
-	uint8_t x[AES_BLOCK_SIZE], a[AES_BLOCK_SIZE];
 	int32_t status = -1;
 
 	if (aad_len > 30 || M > AES_BLOCK_SIZE)
@@ -167,17 +256,12 @@ int wlan_crypto_aes_ccm_ae(const uint8_t *key, size_t key_len,
 	if (aes == NULL)
 		return status;
 
-	aes_ccm_auth_start(aes, M, L, nonce, aad, aad_len, plain_len, x);
-	aes_ccm_auth(aes, plain, plain_len, x);
-
-	/* Encryption */
-	aes_ccm_encr_start(L, nonce, a);
-	aes_ccm_encr(aes, L, plain, plain_len, crypt, a);
-	aes_ccm_encr_auth(aes, M, x, a, auth);
+	status = wlan_crypto_aes_ccm_ae_ctx(aes, nonce, M, plain, plain_len,
+					    aad, aad_len, crypt, auth);
 
 	wlan_crypto_aes_encrypt_deinit(aes);
 
-	return 0;
+	return status;
 }
 
 
@@ -186,10 +270,7 @@ int wlan_crypto_aes_ccm_ad(const uint8_t *key, size_t key_len,
 			const uint8_t *nonce, size_t M, const uint8_t *crypt,
 			size_t crypt_len, const uint8_t *aad, size_t aad_len,
 			const uint8_t *auth, uint8_t *plain){
-	const size_t L = 2;
 	void *aes;
-	uint8_t x[AES_BLOCK_SIZE], a[AES_BLOCK_SIZE];
-	uint8_t t[AES_BLOCK_SIZE];
 	int32_t status = -1;
 
 	if (aad_len > 30 || M > AES_BLOCK_SIZE)
@@ -199,22 +280,10 @@ int wlan_crypto_aes_ccm_ad(const uint8_t *key, size_t key_len,
 	if (aes == NULL)
 		return status;
 
-	/* Decryption */
-	aes_ccm_encr_start(L, nonce, a);
-	aes_ccm_decr_auth(aes, M, a, auth, t);
-
-	/* plaintext = msg XOR (S_1 | S_2 | ... | S_n) */
-	aes_ccm_encr(aes, L, crypt, crypt_len, plain, a);
-
-	aes_ccm_auth_start(aes, M, L, nonce, aad, aad_len, crypt_len, x);
-	aes_ccm_auth(aes, plain, crypt_len, x);
+	status = wlan_crypto_aes_ccm_ad_ctx(aes, nonce, M, crypt, crypt_len,
+					    aad, aad_len, auth, plain);
 
 	wlan_crypto_aes_encrypt_deinit(aes);
 
-	if (qdf_mem_cmp(x, t, M) != 0) {
-		wpa_printf(MSG_EXCESSIVE, "CCM: Auth mismatch");
-		return status;
-	}
-
-	return 0;
+	return status;
 }
@@ -36,6 +36,7 @@ static void xor_block(uint8_t *dst, const uint8_t *src)
 }
 
 
+#ifdef WLAN_CRYPTO_GCM_BITSERIAL
 static void shift_right_block(uint8_t *v)
 {
 	uint32_t val;
@@ -95,6 +96,134 @@ static void gf_mult(const uint8_t *x, const uint8_t *y, uint8_t *z)
 	}
 }
 
+/* Bit-serial path keeps only H around, one bit of x per iteration */
+struct ghash_table {
+	uint8_t h[16];
+};
+
+
+static void ghash_init_table(const uint8_t *h, struct ghash_table *t)
+{
+	qdf_mem_copy(t->h, h, 16);
+}
+
+
+static void ghash_mult(uint8_t *y, const struct ghash_table *t)
+{
+	uint8_t tmp[16];
+
+	gf_mult(y, t->h, tmp);
+	qdf_mem_copy(y, tmp, 16);
+}
+#else
+/*
+ * GF(2^128) element as two big endian 64-bit halves, hi holding bytes
+ * 0..7 of the block. Bit 0 of the field element is the MSB of hi.
+ */
+struct gf128 {
+	uint64_t hi;
+	uint64_t lo;
+};
+
+/* 4-bit Shoup table of multiples of the hash subkey H */
+struct ghash_table {
+	struct gf128 m[16];
+};
+
+/* Reduction of the 4 bits shifted out of Z, multiplied by R */
+static const uint64_t ghash_rem_4bit[16] = {
+	0x0000ULL << 48, 0x1C20ULL << 48, 0x3840ULL << 48, 0x2460ULL << 48,
+	0x7080ULL << 48, 0x6CA0ULL << 48, 0x48C0ULL << 48, 0x54E0ULL << 48,
+	0xE100ULL << 48, 0xFD20ULL << 48, 0xD940ULL << 48, 0xC560ULL << 48,
+	0x9180ULL << 48, 0x8DA0ULL << 48, 0xA9C0ULL << 48, 0xB5E0ULL << 48,
+};
+
+static inline uint64_t ghash_get_be64(const uint8_t *a)
+{
+	return ((uint64_t)wlan_crypto_get_be32(a) << 32) |
+		wlan_crypto_get_be32(a + 4);
+}
+
+
+static inline void ghash_put_be64(uint8_t *a, uint64_t val)
+{
+	wlan_crypto_put_be32(a, val >> 32);
+	wlan_crypto_put_be32(a + 4, val & 0xffffffff);
+}
+
+
+/* V = V * x, i.e. V >> 1 with R folded in for the bit shifted out */
+static inline void ghash_mult_x(struct gf128 *v)
+{
+	uint64_t r = 0xe100000000000000ULL & (0 - (v->lo & 1));
+
+	v->lo = (v->hi << 63) | (v->lo >> 1);
+	v->hi = (v->hi >> 1) ^ r;
+}
+
+
+/* Precompute n * H for every 4-bit n, once per key */
+static void ghash_init_table(const uint8_t *h, struct ghash_table *t)
+{
+	struct gf128 v;
+	int i, j;
+
+	v.hi = ghash_get_be64(h);
+	v.lo = ghash_get_be64(h + 8);
+
+	t->m[0].hi = 0;
+	t->m[0].lo = 0;
+	t->m[8] = v;
+	for (i = 4; i > 0; i >>= 1) {
+		ghash_mult_x(&v);
+		t->m[i] = v;
+	}
+
+	for (i = 2; i < 16; i <<= 1) {
+		for (j = 1; j < i; j++) {
+			t->m[i + j].hi = t->m[i].hi ^ t->m[j].hi;
+			t->m[i + j].lo = t->m[i].lo ^ t->m[j].lo;
+		}
+	}
+}
+
+
+/* Multiplication in GF(2^128): y = y * H, a nibble at a time */
+static void ghash_mult(uint8_t *y, const struct ghash_table *t)
+{
+	struct gf128 z;
+	uint8_t nlo, nhi, rem;
+	int i = 15;
+
+	nlo = y[i] & 0x0f;
+	nhi = y[i] >> 4;
+	z = t->m[nlo];
+
+	for (;;) {
+		rem = z.lo & 0x0f;
+		z.lo = (z.hi << 60) | (z.lo >> 4);
+		z.hi = (z.hi >> 4) ^ ghash_rem_4bit[rem];
+		z.hi ^= t->m[nhi].hi;
+		z.lo ^= t->m[nhi].lo;
+
+		if (--i < 0)
+			break;
+
+		nlo = y[i] & 0x0f;
+		nhi = y[i] >> 4;
+
+		rem = z.lo & 0x0f;
+		z.lo = (z.hi << 60) | (z.lo >> 4);
+		z.hi = (z.hi >> 4) ^ ghash_rem_4bit[rem];
+		z.hi ^= t->m[nlo].hi;
+		z.lo ^= t->m[nlo].lo;
+	}
+
+	ghash_put_be64(y, z.hi);
+	ghash_put_be64(y + 8, z.lo);
+}
+#endif /* WLAN_CRYPTO_GCM_BITSERIAL */
+
 
 static void ghash_start(uint8_t *y)
 {
@@ -103,7 +232,8 @@ static void ghash_start(uint8_t *y)
 }
 
 
-static void ghash(const uint8_t *h, const uint8_t *x, size_t xlen, uint8_t *y)
+static void ghash(const struct ghash_table *h, const uint8_t *x, size_t xlen,
+		  uint8_t *y)
 {
 	size_t m, i;
 	const uint8_t *xpos = x;
@@ -119,8 +249,7 @@ static void ghash(const uint8_t *h, const uint8_t *x, size_t xlen, uint8_t *y)
 		/* dot operation:
 		 * multiplication operation for binary Galois (finite) field of
 		 * 2^128 elements */
-		gf_mult(y, h, tmp);
-		qdf_mem_copy(y, tmp, 16);
+		ghash_mult(y, h);
 	}
 
 	if (x + xlen > xpos) {
@@ -135,8 +264,7 @@ static void ghash(const uint8_t *h, const uint8_t *x, size_t xlen, uint8_t *y)
 		/* dot operation:
 		 * multiplication operation for binary Galois (finite) field of
 		 * 2^128 elements */
-		gf_mult(y, h, tmp);
-		qdf_mem_copy(y, tmp, 16);
+		ghash_mult(y, h);
 	}
 
 	/* Return Y_m */
@@ -193,7 +321,7 @@ static void *aes_gcm_init_hash_subkey(const uint8_t *key, size_t key_len,
 
 
 static void aes_gcm_prepare_j0(const uint8_t *iv, size_t iv_len,
-				const uint8_t *H, uint8_t *J0){
+				const struct ghash_table *H, uint8_t *J0){
 	uint8_t len_buf[16];
 
 	if (iv_len == 12) {
@@ -228,8 +356,9 @@ static void aes_gcm_gctr(void *aes, const uint8_t *J0, const uint8_t *in,
 }
 
 
-static void aes_gcm_ghash(const uint8_t *H, const uint8_t *aad, size_t aad_len,
-			  const uint8_t *crypt, size_t crypt_len, uint8_t *S)
+static void aes_gcm_ghash(const struct ghash_table *H, const uint8_t *aad,
+			  size_t aad_len, const uint8_t *crypt, size_t crypt_len,
+			  uint8_t *S)
 {
 	uint8_t len_buf[16];
 
@@ -258,6 +387,7 @@ int wlan_crypto_aes_gcm_ae(const uint8_t *key, size_t key_len,
 			size_t plain_len, const uint8_t *aad, size_t aad_len,
 			uint8_t *crypt, uint8_t *tag){
 	uint8_t H[AES_BLOCK_SIZE];
+	struct ghash_table Htbl;
 	uint8_t J0[AES_BLOCK_SIZE];
 	uint8_t S[16];
 	void *aes;
@@ -267,12 +397,13 @@ int wlan_crypto_aes_gcm_ae(const uint8_t *key, size_t key_len,
 	if (aes == NULL)
 		return status;
 
-	aes_gcm_prepare_j0(iv, iv_len, H, J0);
+	ghash_init_table(H, &Htbl);
+	aes_gcm_prepare_j0(iv, iv_len, &Htbl, J0);
 
 	/* C = GCTR_K(inc_32(J_0), P) */
 	aes_gcm_gctr(aes, J0, plain, plain_len, crypt);
 
-	aes_gcm_ghash(H, aad, aad_len, crypt, plain_len, S);
+	aes_gcm_ghash(&Htbl, aad, aad_len, crypt, plain_len, S);
 
 	/* T = MSB_t(GCTR_K(J_0, S)) */
 	aes_gctr(aes, J0, S, sizeof(S), tag);
@@ -293,6 +424,7 @@ int wlan_crypto_aes_gcm_ad(const uint8_t *key, size_t key_len,
 			size_t crypt_len, const uint8_t *aad, size_t aad_len,
 			const uint8_t *tag, uint8_t *plain){
 	uint8_t H[AES_BLOCK_SIZE];
+	struct ghash_table Htbl;
 	uint8_t J0[AES_BLOCK_SIZE];
 	uint8_t S[16], T[16];
 	void *aes;
@@ -302,12 +434,13 @@ int wlan_crypto_aes_gcm_ad(const uint8_t *key, size_t key_len,
 	if (aes == NULL)
 		return status;
 
-	aes_gcm_prepare_j0(iv, iv_len, H, J0);
+	ghash_init_table(H, &Htbl);
+	aes_gcm_prepare_j0(iv, iv_len, &Htbl, J0);
 
 	/* P = GCTR_K(inc_32(J_0), C) */
 	aes_gcm_gctr(aes, J0, crypt, crypt_len, plain);
 
-	aes_gcm_ghash(H, aad, aad_len, crypt, crypt_len, S);
+	aes_gcm_ghash(&Htbl, aad, aad_len, crypt, crypt_len, S);
 
 	/* T' = MSB_t(GCTR_K(J_0, S)) */
 	aes_gctr(aes, J0, S, sizeof(S), T);
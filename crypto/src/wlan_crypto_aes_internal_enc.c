@@ -98,19 +98,29 @@ d##3 = TE0(s##3) ^ TE1(s##0) ^ TE2(s##1) ^ TE3(s##2) ^ rk[4 * i + 3]; }
 }
 
 
+int wlan_crypto_aes_encrypt_setup(void *ctx, const uint8_t *key, size_t len)
+{
+	uint32_t *rk = ctx;
+	int res;
+
+	res = wlan_crypto_rijndaelKeySetupEnc(rk, key, len * 8);
+	if (res < 0)
+		return res;
+	rk[AES_PRIV_NR_POS] = res;
+	return 0;
+}
+
+
 void *wlan_crypto_aes_encrypt_init(const uint8_t *key, size_t len)
 {
 	uint32_t *rk;
-	int res;
 	rk = qdf_mem_malloc(AES_PRIV_SIZE);
 	if (rk == NULL)
 		return NULL;
-	res = wlan_crypto_rijndaelKeySetupEnc(rk, key, len * 8);
-	if (res < 0) {
+	if (wlan_crypto_aes_encrypt_setup(rk, key, len) < 0) {
 		qdf_mem_free(rk);
 		return NULL;
 	}
-	rk[AES_PRIV_NR_POS] = res;
 	return rk;
 }
 
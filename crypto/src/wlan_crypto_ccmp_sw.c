@@ -82,22 +82,25 @@ static void ccmp_aad_nonce(const struct wlan_frame_hdr *hdr, const uint8_t *data
 }
 
 
+/*
+ * Decrypts in place: the plaintext is written over the CCMP header so it
+ * directly follows the 802.11 header, and the IV/MIC tail is left for
+ * the caller to trim. The key schedule lives on the stack.
+ */
 uint8_t *wlan_crypto_ccmp_decrypt(const uint8_t *tk,
 					const struct wlan_frame_hdr *hdr,
 					uint8_t *data, size_t data_len){
 	uint8_t aad[30], nonce[13];
+	uint32_t rk[AES_PRIV_SIZE / sizeof(uint32_t)];
 	size_t aad_len;
 	size_t mlen;
-	uint8_t *plain;
+	int ret;
 
 	if (data_len < CCMP_IV_SIZE + WLAN_CRYPTO_MIC_LEN)
 		return NULL;
 
-	plain = qdf_mem_malloc(data_len + AES_BLOCK_SIZE);
-	if (plain == NULL) {
-		crypto_err("mem alloc failed");
+	if (wlan_crypto_aes_encrypt_setup(rk, tk, 16) < 0)
 		return NULL;
-	}
 
 	mlen = data_len - CCMP_IV_SIZE - WLAN_CRYPTO_MIC_LEN;
 
@@ -106,12 +109,13 @@ uint8_t *wlan_crypto_ccmp_decrypt(const uint8_t *tk,
 	wpa_hexdump(MSG_EXCESSIVE, "CCMP AAD", aad, aad_len);
 	wpa_hexdump(MSG_EXCESSIVE, "CCMP nonce", nonce, 13);
 
-	if (wlan_crypto_aes_ccm_ad(tk, 16, nonce,
-					WLAN_CRYPTO_MIC_LEN,
-					data + CCMP_IV_SIZE, mlen,
-					aad, aad_len,
-					data + CCMP_IV_SIZE + mlen,
-					plain) < 0) {
+	ret = wlan_crypto_aes_ccm_ad_ctx(rk, nonce, WLAN_CRYPTO_MIC_LEN,
+					 data + CCMP_IV_SIZE, mlen,
+					 aad, aad_len,
+					 data + CCMP_IV_SIZE + mlen,
+					 data);
+	qdf_mem_set(rk, sizeof(rk), 0);
+	if (ret < 0) {
 		/*uint16_t seq_ctrl = qdf_le16_to_cpu(hdr->seq_ctrl);
 		wpa_printf(MSG_INFO, "Invalid CCMP MIC in frame: A1=" MACSTR
 			" A2=" MACSTR " A3=" MACSTR " seq=%u frag=%u",
@@ -119,13 +123,10 @@ uint8_t *wlan_crypto_ccmp_decrypt(const uint8_t *tk,
 			MAC2STR(hdr->addr3),
 			WLAN_GET_SEQ_SEQ(seq_ctrl),
 			WLAN_GET_SEQ_FRAG(seq_ctrl));*/
-		qdf_mem_free(plain);
 		return NULL;
 	}
-	wpa_hexdump(MSG_EXCESSIVE, "CCMP decrypted", plain, mlen);
+	wpa_hexdump(MSG_EXCESSIVE, "CCMP decrypted", data, mlen);
 
-	qdf_mem_copy(data, plain, data_len);
-	qdf_mem_free(plain);
 	return data;
 }
 
@@ -141,46 +142,42 @@ void ccmp_get_pn(uint8_t *pn, const uint8_t *data)
 }
 
 
+/* Encrypts the payload in place and writes the MIC after it */
 uint8_t *wlan_crypto_ccmp_encrypt(const uint8_t *tk, uint8_t *frame,
 					size_t len, size_t hdrlen){
 	uint8_t aad[30], nonce[13];
+	uint32_t rk[AES_PRIV_SIZE / sizeof(uint32_t)];
 	size_t aad_len, plen;
-	uint8_t *crypt, *pos;
+	uint8_t *pos;
 	struct wlan_frame_hdr *hdr;
+	int ret;
 
 	if (len < hdrlen || hdrlen < 24)
 		return NULL;
+	if (len - hdrlen < CCMP_IV_SIZE + WLAN_CRYPTO_MIC_LEN)
+		return NULL;
 	plen = len - hdrlen - CCMP_IV_SIZE - WLAN_CRYPTO_MIC_LEN;
 
-	crypt = qdf_mem_malloc(hdrlen + CCMP_IV_SIZE + plen
-				+ WLAN_CRYPTO_MIC_LEN + AES_BLOCK_SIZE);
-	if (crypt == NULL) {
-		crypto_err("mem alloc failed");
+	if (wlan_crypto_aes_encrypt_setup(rk, tk, 16) < 0)
 		return NULL;
-	}
-
-	qdf_mem_copy(crypt, frame, hdrlen + CCMP_IV_SIZE);
 
-	hdr = (struct wlan_frame_hdr *) crypt;
+	hdr = (struct wlan_frame_hdr *) frame;
 	hdr->i_fc[1] |= WLAN_FC1_ISWEP;
-	pos = crypt + hdrlen + 8;
+	pos = frame + hdrlen + CCMP_IV_SIZE;
 
 	qdf_mem_set(aad, sizeof(aad), 0);
-	ccmp_aad_nonce(hdr, crypt + hdrlen, aad, &aad_len, nonce);
+	ccmp_aad_nonce(hdr, frame + hdrlen, aad, &aad_len, nonce);
 	wpa_hexdump(MSG_EXCESSIVE, "CCMP AAD", aad, aad_len);
 	wpa_hexdump(MSG_EXCESSIVE, "CCMP nonce", nonce, 13);
 
-	if (wlan_crypto_aes_ccm_ae(tk, 16, nonce, WLAN_CRYPTO_MIC_LEN,
-					frame + hdrlen + CCMP_IV_SIZE,
-			plen, aad, aad_len, pos, pos + plen) < 0) {
-		qdf_mem_free(crypt);
+	ret = wlan_crypto_aes_ccm_ae_ctx(rk, nonce, WLAN_CRYPTO_MIC_LEN,
+					 pos, plen, aad, aad_len,
+					 pos, pos + plen);
+	qdf_mem_set(rk, sizeof(rk), 0);
+	if (ret < 0)
 		return NULL;
-	}
 
-	qdf_mem_copy(frame, crypt, len);
-	wpa_hexdump(MSG_EXCESSIVE, "CCMP encrypted",
-				crypt + hdrlen + CCMP_IV_SIZE, plen);
-	qdf_mem_free(crypt);
+	wpa_hexdump(MSG_EXCESSIVE, "CCMP encrypted", pos, plen);
 
 	return frame;
 }
@@ -41,6 +41,10 @@
 #define STATS_CTX_LOCK_ACQUIRE(lock) qdf_spin_lock_bh(lock)
 #define STATS_CTX_LOCK_RELEASE(lock) qdf_spin_unlock_bh(lock)
 
+/* rate index to cache slot hint, direct mapped on the low rix bits */
+#define WLANSTATS_CACHE_HINT_SIZE 16
+#define WLANSTATS_CACHE_HINT(_rix) ((_rix) & (WLANSTATS_CACHE_HINT_SIZE - 1))
+
 struct cdp_pdev;
 
 /**
@@ -64,6 +68,9 @@ enum dp_ppdu_type {
  * @cur_rate: rate updated last in list
  * @lock: lock protecting list
  * @sojourn: sojourn statistics
+ * @cur_cache_idx: cache index updated last in list
+ * @num_cache_used: number of cache entries in use
+ * @cache_hint: last cache index seen per rate index hint bucket
  */
 struct wlan_peer_tx_rate_stats {
 	struct wlan_tx_rate_stats stats[WLANSTATS_CACHE_SIZE];
@@ -71,6 +78,8 @@ struct wlan_peer_tx_rate_stats {
 	uint32_t cur_rix;
 	uint32_t cur_rate;
 	uint8_t cur_cache_idx;
+	uint8_t num_cache_used;
+	uint8_t cache_hint[WLANSTATS_CACHE_HINT_SIZE];
 };
 
 /**
@@ -79,12 +88,17 @@ struct wlan_peer_tx_rate_stats {
  * @cur_rix: rate index updated last in list
  * @cur_rate: rate updated last in list
  * @lock: lock protecting list
+ * @cur_cache_idx: cache index updated last in list
+ * @num_cache_used: number of cache entries in use
+ * @cache_hint: last cache index seen per rate index hint bucket
  */
 struct wlan_peer_rx_rate_stats {
 	struct wlan_rx_rate_stats stats[WLANSTATS_CACHE_SIZE];
 	uint32_t cur_rix;
 	uint32_t cur_rate;
 	uint32_t cur_cache_idx;
+	uint8_t num_cache_used;
+	uint8_t cache_hint[WLANSTATS_CACHE_HINT_SIZE];
 };
 
 /**
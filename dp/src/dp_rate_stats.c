@@ -123,49 +123,6 @@ wlan_peer_update_avg_tx_rate_stats_user(
 	return flush ? 1 : 0;
 }
 
-static void
-wlan_peer_update_avg_tx_rate_stats(
-				struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
-				struct cdp_tx_completion_ppdu *ppdu)
-{
-	struct wlan_peer_rate_stats_ctx *stats_ctx;
-	struct wlan_avg_rate_stats *avg;
-	struct cdp_tx_completion_ppdu_user *user;
-	int i;
-
-	if (soc_stats_ctx->stats_ver != PEER_EXT_RATE_STATS &&
-	    soc_stats_ctx->stats_ver != PEER_EXT_ALL_STATS)
-		return;
-
-	for (i = 0; i < ppdu->num_users; i++) {
-		user = &ppdu->user[i];
-		STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->tx_ctx_lock);
-		if (user->peer_id == CDP_INVALID_PEER) {
-			dp_warn("no valid peer \n");
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
-			continue;
-		}
-
-		stats_ctx = cdp_peer_get_peerstats_ctx(soc_stats_ctx->soc,
-						       ppdu->vdev_id,
-						       user->mac_addr);
-		if (qdf_unlikely(!stats_ctx)) {
-			dp_warn("peer rate stats ctx is NULL, return");
-			dp_warn("peer_mac:  " QDF_MAC_ADDR_FMT,
-				QDF_MAC_ADDR_REF(user->mac_addr));
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
-			continue;
-		}
-
-		avg = &stats_ctx->avg.stats;
-
-		if (wlan_peer_update_avg_tx_rate_stats_user(avg, ppdu, user))
-			wlan_peer_flush_avg_rate_stats(soc_stats_ctx,
-						       stats_ctx);
-		STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
-	}
-}
-
 static int
 wlan_peer_update_avg_rx_rate_stats_user(struct wlan_avg_rate_stats *avg,
 					struct cdp_rx_indication_ppdu *ppdu,
@@ -244,51 +201,6 @@ wlan_peer_update_avg_rx_rate_stats_user(struct wlan_avg_rate_stats *avg,
 	return flush ? 1 : 0;
 }
 
-static void
-wlan_peer_update_avg_rx_rate_stats(
-				struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
-				struct cdp_rx_indication_ppdu *ppdu)
-{
-	struct wlan_peer_rate_stats_ctx *stats_ctx;
-	struct wlan_avg_rate_stats *avg;
-	struct cdp_rx_stats_ppdu_user *user;
-	int i;
-
-	if (soc_stats_ctx->stats_ver != PEER_EXT_RATE_STATS &&
-	    soc_stats_ctx->stats_ver != PEER_EXT_ALL_STATS)
-		return;
-
-	for (i = 0; i < ppdu->num_users; i++) {
-		user = &ppdu->user[i];
-
-		STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->rx_ctx_lock);
-
-		if (user->peer_id == CDP_INVALID_PEER) {
-			dp_warn("no valid peer \n");
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-			continue;
-		}
-
-		stats_ctx = cdp_peer_get_peerstats_ctx(soc_stats_ctx->soc,
-						       ppdu->vdev_id,
-						       user->mac_addr);
-		if (qdf_unlikely(!stats_ctx)) {
-			dp_warn("peer rate stats ctx is NULL, return");
-			dp_warn("peer_mac:  " QDF_MAC_ADDR_FMT,
-				QDF_MAC_ADDR_REF(user->mac_addr));
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-			continue;
-		}
-
-		avg = &stats_ctx->avg.stats;
-
-		if (wlan_peer_update_avg_rx_rate_stats_user(avg, ppdu, user))
-			wlan_peer_flush_avg_rate_stats(soc_stats_ctx,
-						       stats_ctx);
-		STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-	}
-}
-
 static void
 wlan_peer_read_ewma_avg_rssi(struct wlan_rx_rate_stats *rx_stats)
 {
@@ -349,7 +261,10 @@ wlan_peer_flush_rx_rate_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
 	for (idx = 0; idx < WLANSTATS_CACHE_SIZE; idx++)
 		rx_stats->stats[idx].ratecode = INVALID_CACHE_IDX;
 
+	rx_stats->cur_rix = 0;
+	rx_stats->cur_rate = 0;
 	rx_stats->cur_cache_idx = 0;
+	rx_stats->num_cache_used = 0;
 }
 
 static void
@@ -411,7 +326,10 @@ wlan_peer_flush_tx_rate_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
 	for (idx = 0; idx < WLANSTATS_CACHE_SIZE; idx++)
 		tx_stats->stats[idx].ratecode = INVALID_CACHE_IDX;
 
+	tx_stats->cur_rix = 0;
+	tx_stats->cur_rate = 0;
 	tx_stats->cur_cache_idx = 0;
+	tx_stats->num_cache_used = 0;
 }
 
 static void
@@ -613,239 +531,182 @@ __wlan_peer_update_rx_rate_stats(struct wlan_rx_rate_stats *__rx_stats,
 }
 
 static void
-wlan_peer_update_tx_link_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
-			       struct cdp_tx_completion_ppdu *cdp_tx_ppdu)
+wlan_peer_update_tx_link_stats(struct wlan_peer_rate_stats_ctx *stats_ctx,
+			       struct cdp_tx_completion_ppdu_user *ppdu_user)
 {
-	struct cdp_tx_completion_ppdu_user *ppdu_user;
-	struct wlan_peer_rate_stats_ctx *stats_ctx;
 	struct wlan_tx_link_stats *tx_stats;
-	uint8_t user_idx;
 
-	if (soc_stats_ctx->stats_ver != PEER_EXT_LINK_STATS &&
-	    soc_stats_ctx->stats_ver != PEER_EXT_ALL_STATS)
-		return;
+	tx_stats = &stats_ctx->link_metrics->tx.stats;
 
-	for (user_idx = 0; user_idx < cdp_tx_ppdu->num_users; user_idx++) {
-		ppdu_user = &cdp_tx_ppdu->user[user_idx];
+	tx_stats->num_ppdus += ppdu_user->long_retries + 1;
+	tx_stats->bytes += ppdu_user->success_bytes;
+	tx_stats->mpdu_failed += ppdu_user->mpdu_failed;
+	tx_stats->mpdu_success += ppdu_user->mpdu_success;
 
-		STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->tx_ctx_lock);
-		stats_ctx = cdp_peer_get_peerstats_ctx(soc_stats_ctx->soc,
-						       cdp_tx_ppdu->vdev_id,
-						       ppdu_user->mac_addr);
+	if (ppdu_user->ppdu_type == DP_PPDU_TYPE_SU) {
+		tx_stats->phy_rate_lpf_avg_su =
+			dp_ath_rate_lpf(tx_stats->phy_rate_lpf_avg_su,
+					ppdu_user->tx_ratekbps);
+	} else if (ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_OFDMA ||
+		   ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_MIMO) {
+		tx_stats->phy_rate_lpf_avg_mu =
+			dp_ath_rate_lpf(tx_stats->phy_rate_lpf_avg_mu,
+					ppdu_user->tx_ratekbps);
 
-		if (qdf_unlikely(!stats_ctx)) {
-			dp_warn("peer rate stats ctx is NULL, return");
-			dp_warn("peer_mac:  " QDF_MAC_ADDR_FMT,
-				QDF_MAC_ADDR_REF(ppdu_user->mac_addr));
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
-			continue;
-		}
-
-		tx_stats = &stats_ctx->link_metrics->tx.stats;
+		if (ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_OFDMA)
+			tx_stats->ofdma_usage++;
 
+		if (ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_MIMO)
+			tx_stats->mu_mimo_usage++;
+	}
 
-		tx_stats->num_ppdus += ppdu_user->long_retries + 1;
-		tx_stats->bytes += ppdu_user->success_bytes;
-		tx_stats->mpdu_failed += ppdu_user->mpdu_failed;
-		tx_stats->mpdu_success += ppdu_user->mpdu_success;
-
-		if (ppdu_user->ppdu_type == DP_PPDU_TYPE_SU) {
-			tx_stats->phy_rate_lpf_avg_su =
-				dp_ath_rate_lpf(tx_stats->phy_rate_lpf_avg_su,
-						ppdu_user->tx_ratekbps);
-		} else if (ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_OFDMA ||
-			   ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_MIMO) {
-			tx_stats->phy_rate_lpf_avg_mu =
-				dp_ath_rate_lpf(tx_stats->phy_rate_lpf_avg_mu,
-						ppdu_user->tx_ratekbps);
-
-			if (ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_OFDMA)
-				tx_stats->ofdma_usage++;
-
-			if (ppdu_user->ppdu_type == DP_PPDU_TYPE_MU_MIMO)
-				tx_stats->mu_mimo_usage++;
-		}
-
-		tx_stats->bw.usage_total += GET_BW_FROM_BW_ENUM(ppdu_user->bw);
-
-		if (ppdu_user->bw < BW_USAGE_MAX_SIZE) {
-			if (tx_stats->bw.usage_max < ppdu_user->bw)
-				tx_stats->bw.usage_max = ppdu_user->bw;
-			tx_stats->bw.usage_counter[ppdu_user->bw]++;
-		}
-
-		if (ppdu_user->ack_rssi_valid)
-			qdf_ewma_rx_rssi_add(&tx_stats->ack_rssi,
-					     ppdu_user->usr_ack_rssi);
+	tx_stats->bw.usage_total += GET_BW_FROM_BW_ENUM(ppdu_user->bw);
 
-		STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
+	if (ppdu_user->bw < BW_USAGE_MAX_SIZE) {
+		if (tx_stats->bw.usage_max < ppdu_user->bw)
+			tx_stats->bw.usage_max = ppdu_user->bw;
+		tx_stats->bw.usage_counter[ppdu_user->bw]++;
 	}
+
+	if (ppdu_user->ack_rssi_valid)
+		qdf_ewma_rx_rssi_add(&tx_stats->ack_rssi,
+				     ppdu_user->usr_ack_rssi);
 }
 
 static void
-wlan_peer_update_rx_link_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
-			       struct cdp_rx_indication_ppdu *cdp_rx_ppdu)
+wlan_peer_update_rx_link_stats(struct wlan_peer_rate_stats_ctx *stats_ctx,
+			       struct cdp_rx_indication_ppdu *cdp_rx_ppdu,
+			       struct cdp_rx_stats_ppdu_user *ppdu_user)
 {
-	struct cdp_rx_stats_ppdu_user *ppdu_user;
-	struct wlan_peer_rate_stats_ctx *stats_ctx;
 	struct wlan_rx_link_stats *rx_stats;
-	uint8_t user_idx;
 
-	if (soc_stats_ctx->stats_ver != PEER_EXT_LINK_STATS &&
-	    soc_stats_ctx->stats_ver != PEER_EXT_ALL_STATS)
-		return;
+	rx_stats = &stats_ctx->link_metrics->rx.stats;
+
+	rx_stats->num_ppdus++;
+	rx_stats->bytes += ppdu_user->mpdu_ok_byte_count;
+	rx_stats->mpdu_retries += ppdu_user->retries;
+	rx_stats->num_mpdus += ppdu_user->mpdu_cnt_fcs_ok;
+
+	if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_SU) {
+		rx_stats->phy_rate_lpf_avg_su =
+			dp_ath_rate_lpf(rx_stats->phy_rate_lpf_avg_su,
+					cdp_rx_ppdu->rx_ratekbps);
+		qdf_ewma_rx_rssi_add(&rx_stats->su_rssi,
+				     cdp_rx_ppdu->rssi);
+	} else if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_OFDMA ||
+		   cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_MIMO) {
+		rx_stats->phy_rate_lpf_avg_mu =
+			dp_ath_rate_lpf(rx_stats->phy_rate_lpf_avg_mu,
+					cdp_rx_ppdu->rx_ratekbps);
+
+		if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_OFDMA)
+			rx_stats->ofdma_usage++;
+
+		if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_MIMO)
+			rx_stats->mu_mimo_usage++;
+	}
 
-	for (user_idx = 0;
-	     user_idx < cdp_rx_ppdu->num_users && user_idx < CDP_MU_MAX_USERS;
-	     user_idx++) {
-		ppdu_user = &cdp_rx_ppdu->user[user_idx];
+	rx_stats->bw.usage_total += GET_BW_FROM_BW_ENUM(cdp_rx_ppdu->u.bw);
 
-		if (ppdu_user->peer_id == CDP_INVALID_PEER)
-			continue;
+	if (cdp_rx_ppdu->u.bw < BW_USAGE_MAX_SIZE) {
+		if (rx_stats->bw.usage_max < cdp_rx_ppdu->u.bw)
+			rx_stats->bw.usage_max = cdp_rx_ppdu->u.bw;
+		rx_stats->bw.usage_counter[cdp_rx_ppdu->u.bw]++;
+	}
+}
 
-		STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->rx_ctx_lock);
-		stats_ctx = cdp_peer_get_peerstats_ctx(soc_stats_ctx->soc,
-						       ppdu_user->vdev_id,
-						       ppdu_user->mac_addr);
+/**
+ * wlan_peer_rx_rate_cache_idx() - get rx rate cache slot for a rate
+ * @rx_stats: peer rx rate statistics
+ * @rix: rate index
+ * @rate: rate in kbps
+ *
+ * Slots are handed out in order, so only the first @num_cache_used
+ * entries are scanned. The per rix hint resolves the common case
+ * without a scan and is re-validated against the slot on every use.
+ *
+ * Return: cache slot, WLANSTATS_CACHE_SIZE if the cache is full
+ */
+static inline uint8_t
+wlan_peer_rx_rate_cache_idx(struct wlan_peer_rx_rate_stats *rx_stats,
+			    uint32_t rix, uint32_t rate)
+{
+	uint8_t *hint = &rx_stats->cache_hint[WLANSTATS_CACHE_HINT(rix)];
+	struct wlan_rx_rate_stats *__rx_stats;
+	uint8_t cache_idx = *hint;
 
-		if (qdf_unlikely(!stats_ctx)) {
-			dp_warn("peer rate stats ctx is NULL, return");
-			dp_warn("peer_mac:  " QDF_MAC_ADDR_FMT,
-				QDF_MAC_ADDR_REF(ppdu_user->mac_addr));
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-			continue;
-		}
+	if (qdf_likely(cache_idx < rx_stats->num_cache_used)) {
+		__rx_stats = &rx_stats->stats[cache_idx];
+		if (GET_DP_PEER_STATS_RIX(__rx_stats->ratecode) == rix &&
+		    __rx_stats->rate == rate)
+			return cache_idx;
+	}
 
-		rx_stats = &stats_ctx->link_metrics->rx.stats;
-
-		rx_stats->num_ppdus++;
-		rx_stats->bytes += ppdu_user->mpdu_ok_byte_count;
-		rx_stats->mpdu_retries += ppdu_user->retries;
-		rx_stats->num_mpdus += ppdu_user->mpdu_cnt_fcs_ok;
-
-		if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_SU) {
-			rx_stats->phy_rate_lpf_avg_su =
-				dp_ath_rate_lpf(rx_stats->phy_rate_lpf_avg_su,
-						cdp_rx_ppdu->rx_ratekbps);
-			qdf_ewma_rx_rssi_add(&rx_stats->su_rssi,
-					     cdp_rx_ppdu->rssi);
-		} else if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_OFDMA ||
-			   cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_MIMO) {
-			rx_stats->phy_rate_lpf_avg_mu =
-				dp_ath_rate_lpf(rx_stats->phy_rate_lpf_avg_mu,
-						cdp_rx_ppdu->rx_ratekbps);
-
-			if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_OFDMA)
-				rx_stats->ofdma_usage++;
-
-			if (cdp_rx_ppdu->u.ppdu_type == DP_PPDU_TYPE_MU_MIMO)
-				rx_stats->mu_mimo_usage++;
-		}
+	for (cache_idx = 0; cache_idx < rx_stats->num_cache_used;
+	     cache_idx++) {
+		__rx_stats = &rx_stats->stats[cache_idx];
+		if (GET_DP_PEER_STATS_RIX(__rx_stats->ratecode) == rix &&
+		    __rx_stats->rate == rate)
+			break;
+	}
 
-		rx_stats->bw.usage_total +=
-					GET_BW_FROM_BW_ENUM(cdp_rx_ppdu->u.bw);
+	if (cache_idx == WLANSTATS_CACHE_SIZE)
+		return cache_idx;
 
-		if (cdp_rx_ppdu->u.bw < BW_USAGE_MAX_SIZE) {
-			if (rx_stats->bw.usage_max < cdp_rx_ppdu->u.bw)
-				rx_stats->bw.usage_max = cdp_rx_ppdu->u.bw;
-			rx_stats->bw.usage_counter[cdp_rx_ppdu->u.bw]++;
-		}
+	if (cache_idx == rx_stats->num_cache_used)
+		rx_stats->num_cache_used++;
 
-		STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-	}
+	*hint = cache_idx;
+
+	return cache_idx;
 }
 
 static void
 wlan_peer_update_rx_rate_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
-			       struct cdp_rx_indication_ppdu *cdp_rx_ppdu)
+			       struct wlan_peer_rate_stats_ctx *stats_ctx,
+			       struct cdp_rx_indication_ppdu *cdp_rx_ppdu,
+			       uint8_t user_idx)
 {
-	struct wlan_peer_rate_stats_ctx *stats_ctx;
+	struct cdp_rx_stats_ppdu_user *ppdu_user = &cdp_rx_ppdu->user[user_idx];
 	struct wlan_peer_rx_rate_stats *rx_stats;
-	struct wlan_rx_rate_stats *__rx_stats;
-	struct cdp_rx_stats_ppdu_user *ppdu_user;
 	uint8_t cache_idx;
-	uint8_t user_idx;
-	uint8_t max_users;
-	bool idx_match = false;
 
-	if (soc_stats_ctx->stats_ver != PEER_EXT_RATE_STATS &&
-	    soc_stats_ctx->stats_ver != PEER_EXT_ALL_STATS)
+	if (qdf_unlikely(!ppdu_user->rx_ratekbps || !ppdu_user->rix ||
+			 ppdu_user->rix > DP_RATE_TABLE_SIZE))
 		return;
 
-	user_idx = 0;
-	max_users = QDF_MIN(cdp_rx_ppdu->num_users, CDP_MU_MAX_USERS);
-
-	for (user_idx = 0; user_idx < max_users; user_idx++) {
-		ppdu_user = &cdp_rx_ppdu->user[user_idx];
-
-		if (ppdu_user->peer_id == CDP_INVALID_PEER)
-			continue;
-
-		STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->rx_ctx_lock);
-
-		stats_ctx = cdp_peer_get_peerstats_ctx(soc_stats_ctx->soc,
-						       ppdu_user->vdev_id,
-						       ppdu_user->mac_addr);
-
-		if (qdf_unlikely(!stats_ctx)) {
-			dp_warn("peer rate stats ctx is NULL, return");
-			dp_warn("peer_mac:  " QDF_MAC_ADDR_FMT,
-				QDF_MAC_ADDR_REF(ppdu_user->mac_addr));
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-			continue;
-		}
-
-		rx_stats = &stats_ctx->rate_stats->rx;
-
-		if (qdf_unlikely(!ppdu_user->rx_ratekbps || !ppdu_user->rix ||
-				 ppdu_user->rix > DP_RATE_TABLE_SIZE)) {
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-			continue;
-		}
+	rx_stats = &stats_ctx->rate_stats->rx;
 
-		if (qdf_likely(rx_stats->cur_rix == ppdu_user->rix &&
-			       rx_stats->cur_rate == ppdu_user->rx_ratekbps)) {
-			__rx_stats = &rx_stats->stats[rx_stats->cur_cache_idx];
-			__wlan_peer_update_rx_rate_stats(__rx_stats,
-							 cdp_rx_ppdu, user_idx);
-			soc_stats_ctx->rxs_last_idx_cache_hit++;
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
-			continue;
-		}
+	if (qdf_likely(rx_stats->cur_rix == ppdu_user->rix &&
+		       rx_stats->cur_rate == ppdu_user->rx_ratekbps)) {
+		__wlan_peer_update_rx_rate_stats(
+				&rx_stats->stats[rx_stats->cur_cache_idx],
+				cdp_rx_ppdu, user_idx);
+		soc_stats_ctx->rxs_last_idx_cache_hit++;
+		return;
+	}
 
-		/* check if cache is available */
-		for (cache_idx = 0; cache_idx < WLANSTATS_CACHE_SIZE; cache_idx++) {
-			__rx_stats = &rx_stats->stats[cache_idx];
-			if ((__rx_stats->ratecode == INVALID_CACHE_IDX) ||
-			    ((GET_DP_PEER_STATS_RIX(__rx_stats->ratecode) == ppdu_user->rix) &&
-			     (__rx_stats->rate == ppdu_user->rx_ratekbps))) {
-				idx_match = true;
-				break;
-			}
-		}
-		/* if index matches or found empty index, update stats to that
-		 * cache index else flush cache and update stats to cache index
-		 * zero
-		 */
-		if (idx_match) {
-			__wlan_peer_update_rx_rate_stats(__rx_stats,
-							 cdp_rx_ppdu, user_idx);
-			rx_stats->cur_rix = ppdu_user->rix;
-			rx_stats->cur_rate = ppdu_user->rx_ratekbps;
-			rx_stats->cur_cache_idx = cache_idx;
-			soc_stats_ctx->rxs_cache_hit++;
-		} else {
-			wlan_peer_flush_rx_rate_stats(soc_stats_ctx, stats_ctx);
-			__rx_stats = &rx_stats->stats[0];
-			__wlan_peer_update_rx_rate_stats(__rx_stats,
-							 cdp_rx_ppdu, user_idx);
-			rx_stats->cur_rix = ppdu_user->rix;
-			rx_stats->cur_rate = ppdu_user->rx_ratekbps;
-			rx_stats->cur_cache_idx = 0;
-			soc_stats_ctx->rxs_cache_miss++;
-		}
-		STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
+	cache_idx = wlan_peer_rx_rate_cache_idx(rx_stats, ppdu_user->rix,
+						ppdu_user->rx_ratekbps);
+	/* if index matches or found empty index, update stats to that
+	 * cache index else flush cache and update stats to cache index
+	 * zero
+	 */
+	if (cache_idx < WLANSTATS_CACHE_SIZE) {
+		soc_stats_ctx->rxs_cache_hit++;
+	} else {
+		soc_stats_ctx->rxs_cache_miss++;
+		wlan_peer_flush_rx_rate_stats(soc_stats_ctx, stats_ctx);
+		cache_idx = wlan_peer_rx_rate_cache_idx(rx_stats,
+							ppdu_user->rix,
+							ppdu_user->rx_ratekbps);
 	}
+
+	__wlan_peer_update_rx_rate_stats(&rx_stats->stats[cache_idx],
+					 cdp_rx_ppdu, user_idx);
+	rx_stats->cur_rix = ppdu_user->rix;
+	rx_stats->cur_rate = ppdu_user->rx_ratekbps;
+	rx_stats->cur_cache_idx = cache_idx;
 }
 
 static inline void
@@ -877,92 +738,219 @@ __wlan_peer_update_tx_rate_stats(struct wlan_tx_rate_stats *__tx_stats,
 	__tx_stats->num_retries += ppdu_user->mpdu_failed;
 }
 
+/**
+ * wlan_peer_tx_rate_cache_idx() - get tx rate cache slot for a rate
+ * @tx_stats: peer tx rate statistics
+ * @rix: rate index
+ * @rate: rate in kbps
+ *
+ * Tx counterpart of wlan_peer_rx_rate_cache_idx().
+ *
+ * Return: cache slot, WLANSTATS_CACHE_SIZE if the cache is full
+ */
+static inline uint8_t
+wlan_peer_tx_rate_cache_idx(struct wlan_peer_tx_rate_stats *tx_stats,
+			    uint32_t rix, uint32_t rate)
+{
+	uint8_t *hint = &tx_stats->cache_hint[WLANSTATS_CACHE_HINT(rix)];
+	struct wlan_tx_rate_stats *__tx_stats;
+	uint8_t cache_idx = *hint;
+
+	if (qdf_likely(cache_idx < tx_stats->num_cache_used)) {
+		__tx_stats = &tx_stats->stats[cache_idx];
+		if (GET_DP_PEER_STATS_RIX(__tx_stats->ratecode) == rix &&
+		    __tx_stats->rate == rate)
+			return cache_idx;
+	}
+
+	for (cache_idx = 0; cache_idx < tx_stats->num_cache_used;
+	     cache_idx++) {
+		__tx_stats = &tx_stats->stats[cache_idx];
+		if (GET_DP_PEER_STATS_RIX(__tx_stats->ratecode) == rix &&
+		    __tx_stats->rate == rate)
+			break;
+	}
+
+	if (cache_idx == WLANSTATS_CACHE_SIZE)
+		return cache_idx;
+
+	if (cache_idx == tx_stats->num_cache_used)
+		tx_stats->num_cache_used++;
+
+	*hint = cache_idx;
+
+	return cache_idx;
+}
+
 static void
 wlan_peer_update_tx_rate_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
+			       struct wlan_peer_rate_stats_ctx *stats_ctx,
+			       struct cdp_tx_completion_ppdu_user *ppdu_user)
+{
+	struct wlan_peer_tx_rate_stats *tx_stats;
+	uint8_t cache_idx;
+
+	if (qdf_unlikely(!ppdu_user->tx_ratekbps || !ppdu_user->rix ||
+			 ppdu_user->rix > DP_RATE_TABLE_SIZE))
+		return;
+
+	tx_stats = &stats_ctx->rate_stats->tx;
+
+	if (qdf_likely(tx_stats->cur_rix == ppdu_user->rix &&
+		       tx_stats->cur_rate == ppdu_user->tx_ratekbps)) {
+		__wlan_peer_update_tx_rate_stats(
+				&tx_stats->stats[tx_stats->cur_cache_idx],
+				ppdu_user);
+		soc_stats_ctx->txs_last_idx_cache_hit++;
+		return;
+	}
+
+	cache_idx = wlan_peer_tx_rate_cache_idx(tx_stats, ppdu_user->rix,
+						ppdu_user->tx_ratekbps);
+	/* if index matches or found empty index,
+	 * update stats to that cache index
+	 * else flush cache and update stats to cache index zero
+	 */
+	if (cache_idx < WLANSTATS_CACHE_SIZE) {
+		soc_stats_ctx->txs_cache_hit++;
+	} else {
+		soc_stats_ctx->txs_cache_miss++;
+		wlan_peer_flush_tx_rate_stats(soc_stats_ctx, stats_ctx);
+		cache_idx = wlan_peer_tx_rate_cache_idx(tx_stats,
+							ppdu_user->rix,
+							ppdu_user->tx_ratekbps);
+	}
+
+	__wlan_peer_update_tx_rate_stats(&tx_stats->stats[cache_idx],
+					 ppdu_user);
+	tx_stats->cur_rix = ppdu_user->rix;
+	tx_stats->cur_rate = ppdu_user->tx_ratekbps;
+	tx_stats->cur_cache_idx = cache_idx;
+}
+
+/**
+ * wlan_peer_update_tx_ppdu_stats() - update peer stats for a tx PPDU
+ * @soc_stats_ctx: soc rate stats context
+ * @cdp_tx_ppdu: tx completion PPDU descriptor
+ *
+ * The tx context lock is taken once for the whole PPDU and each user's
+ * peer context is resolved once for the rate, link and avg updates.
+ *
+ * Return: none
+ */
+static void
+wlan_peer_update_tx_ppdu_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
 			       struct cdp_tx_completion_ppdu *cdp_tx_ppdu)
 {
 	struct cdp_tx_completion_ppdu_user *ppdu_user;
 	struct wlan_peer_rate_stats_ctx *stats_ctx;
-	struct wlan_peer_tx_rate_stats *tx_stats;
-	struct wlan_tx_rate_stats *__tx_stats;
-	uint8_t cache_idx;
+	bool rate_stats_en;
+	bool link_stats_en;
 	uint8_t user_idx;
-	bool idx_match = false;
 
-	if (soc_stats_ctx->stats_ver != PEER_EXT_RATE_STATS &&
-	    soc_stats_ctx->stats_ver != PEER_EXT_ALL_STATS)
+	rate_stats_en = soc_stats_ctx->stats_ver == PEER_EXT_RATE_STATS ||
+			soc_stats_ctx->stats_ver == PEER_EXT_ALL_STATS;
+	link_stats_en = soc_stats_ctx->stats_ver == PEER_EXT_LINK_STATS ||
+			soc_stats_ctx->stats_ver == PEER_EXT_ALL_STATS;
+	if (!rate_stats_en && !link_stats_en)
 		return;
 
+	STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->tx_ctx_lock);
 	for (user_idx = 0; user_idx < cdp_tx_ppdu->num_users; user_idx++) {
 		ppdu_user = &cdp_tx_ppdu->user[user_idx];
 
-		STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->tx_ctx_lock);
 		stats_ctx = cdp_peer_get_peerstats_ctx(soc_stats_ctx->soc,
 						       cdp_tx_ppdu->vdev_id,
 						       ppdu_user->mac_addr);
-
-		if (qdf_unlikely(!ppdu_user->tx_ratekbps || !ppdu_user->rix ||
-				 ppdu_user->rix > DP_RATE_TABLE_SIZE)) {
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
-			continue;
-		}
-
 		if (qdf_unlikely(!stats_ctx)) {
 			dp_warn("peer rate stats ctx is NULL, investigate");
 			dp_warn("peer_mac: " QDF_MAC_ADDR_FMT,
 				QDF_MAC_ADDR_REF(ppdu_user->mac_addr));
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
 			continue;
 		}
 
-		tx_stats = &stats_ctx->rate_stats->tx;
+		if (link_stats_en)
+			wlan_peer_update_tx_link_stats(stats_ctx, ppdu_user);
 
-		if (qdf_likely(tx_stats->cur_rix == ppdu_user->rix &&
-			       tx_stats->cur_rate == ppdu_user->tx_ratekbps)) {
-			__tx_stats = &tx_stats->stats[tx_stats->cur_cache_idx];
-			__wlan_peer_update_tx_rate_stats(__tx_stats, ppdu_user);
-			soc_stats_ctx->txs_last_idx_cache_hit++;
-			STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
+		if (!rate_stats_en)
 			continue;
-		}
 
-		/* check if cache is available */
-		for (cache_idx = 0; cache_idx < WLANSTATS_CACHE_SIZE;
-					cache_idx++) {
-			__tx_stats = &tx_stats->stats[cache_idx];
+		wlan_peer_update_tx_rate_stats(soc_stats_ctx, stats_ctx,
+					       ppdu_user);
 
-			if ((__tx_stats->ratecode == INVALID_CACHE_IDX) ||
-			    ((GET_DP_PEER_STATS_RIX(__tx_stats->ratecode) == ppdu_user->rix) &&
-			     (__tx_stats->rate == ppdu_user->tx_ratekbps))) {
-				idx_match = true;
-				break;
-			}
-		}
-		/* if index matches or found empty index,
-		 * update stats to that cache index
-		 * else flush cache and update stats to cache index zero
-		 */
-		if (idx_match) {
-			soc_stats_ctx->txs_cache_hit++;
-
-			__wlan_peer_update_tx_rate_stats(__tx_stats,
-							 ppdu_user);
-			tx_stats->cur_rix = ppdu_user->rix;
-			tx_stats->cur_rate = ppdu_user->tx_ratekbps;
-			tx_stats->cur_cache_idx = cache_idx;
-		} else {
-			soc_stats_ctx->txs_cache_miss++;
-
-			wlan_peer_flush_tx_rate_stats(soc_stats_ctx, stats_ctx);
-			__tx_stats = &tx_stats->stats[0];
-			__wlan_peer_update_tx_rate_stats(__tx_stats,
-							 ppdu_user);
-			tx_stats->cur_rix = ppdu_user->rix;
-			tx_stats->cur_rate = ppdu_user->tx_ratekbps;
-			tx_stats->cur_cache_idx = 0;
+		if (ppdu_user->peer_id != CDP_INVALID_PEER &&
+		    wlan_peer_update_avg_tx_rate_stats_user(&stats_ctx->avg.stats,
+							    cdp_tx_ppdu,
+							    ppdu_user))
+			wlan_peer_flush_avg_rate_stats(soc_stats_ctx,
+						       stats_ctx);
+	}
+	STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
+}
+
+/**
+ * wlan_peer_update_rx_ppdu_stats() - update peer stats for an rx PPDU
+ * @soc_stats_ctx: soc rate stats context
+ * @cdp_rx_ppdu: rx indication PPDU descriptor
+ *
+ * Rx counterpart of wlan_peer_update_tx_ppdu_stats().
+ *
+ * Return: none
+ */
+static void
+wlan_peer_update_rx_ppdu_stats(struct wlan_soc_rate_stats_ctx *soc_stats_ctx,
+			       struct cdp_rx_indication_ppdu *cdp_rx_ppdu)
+{
+	struct cdp_rx_stats_ppdu_user *ppdu_user;
+	struct wlan_peer_rate_stats_ctx *stats_ctx;
+	bool rate_stats_en;
+	bool link_stats_en;
+	uint8_t user_idx;
+	uint8_t max_users;
+
+	rate_stats_en = soc_stats_ctx->stats_ver == PEER_EXT_RATE_STATS ||
+			soc_stats_ctx->stats_ver == PEER_EXT_ALL_STATS;
+	link_stats_en = soc_stats_ctx->stats_ver == PEER_EXT_LINK_STATS ||
+			soc_stats_ctx->stats_ver == PEER_EXT_ALL_STATS;
+	if (!rate_stats_en && !link_stats_en)
+		return;
+
+	max_users = QDF_MIN(cdp_rx_ppdu->num_users, CDP_MU_MAX_USERS);
+
+	STATS_CTX_LOCK_ACQUIRE(&soc_stats_ctx->rx_ctx_lock);
+	for (user_idx = 0; user_idx < max_users; user_idx++) {
+		ppdu_user = &cdp_rx_ppdu->user[user_idx];
+
+		if (ppdu_user->peer_id == CDP_INVALID_PEER)
+			continue;
+
+		stats_ctx = cdp_peer_get_peerstats_ctx(soc_stats_ctx->soc,
+						       ppdu_user->vdev_id,
+						       ppdu_user->mac_addr);
+		if (qdf_unlikely(!stats_ctx)) {
+			dp_warn("peer rate stats ctx is NULL, return");
+			dp_warn("peer_mac:  " QDF_MAC_ADDR_FMT,
+				QDF_MAC_ADDR_REF(ppdu_user->mac_addr));
+			continue;
 		}
-		STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->tx_ctx_lock);
+
+		if (link_stats_en)
+			wlan_peer_update_rx_link_stats(stats_ctx, cdp_rx_ppdu,
+						       ppdu_user);
+
+		if (!rate_stats_en)
+			continue;
+
+		wlan_peer_update_rx_rate_stats(soc_stats_ctx, stats_ctx,
+					       cdp_rx_ppdu, user_idx);
+
+		if (wlan_peer_update_avg_rx_rate_stats_user(&stats_ctx->avg.stats,
+							    cdp_rx_ppdu,
+							    ppdu_user))
+			wlan_peer_flush_avg_rate_stats(soc_stats_ctx,
+						       stats_ctx);
 	}
+	STATS_CTX_LOCK_RELEASE(&soc_stats_ctx->rx_ctx_lock);
 }
 
 static void
@@ -1025,17 +1013,13 @@ void wlan_peer_update_rate_stats(void *ctx,
 	case WDI_EVENT_TX_PPDU_DESC:
 		cdp_tx_ppdu = (struct cdp_tx_completion_ppdu *)
 					qdf_nbuf_data(nbuf);
-		wlan_peer_update_tx_rate_stats(soc_stats_ctx, cdp_tx_ppdu);
-		wlan_peer_update_tx_link_stats(soc_stats_ctx, cdp_tx_ppdu);
-		wlan_peer_update_avg_tx_rate_stats(soc_stats_ctx, cdp_tx_ppdu);
+		wlan_peer_update_tx_ppdu_stats(soc_stats_ctx, cdp_tx_ppdu);
 		qdf_nbuf_free(nbuf);
 		break;
 	case WDI_EVENT_RX_PPDU_DESC:
 		cdp_rx_ppdu = (struct cdp_rx_indication_ppdu *)
 					qdf_nbuf_data(nbuf);
-		wlan_peer_update_rx_rate_stats(soc_stats_ctx, cdp_rx_ppdu);
-		wlan_peer_update_rx_link_stats(soc_stats_ctx, cdp_rx_ppdu);
-		wlan_peer_update_avg_rx_rate_stats(soc_stats_ctx, cdp_rx_ppdu);
+		wlan_peer_update_rx_ppdu_stats(soc_stats_ctx, cdp_rx_ppdu);
 		qdf_nbuf_free(nbuf);
 		break;
 	case WDI_EVENT_TX_SOJOURN_STAT:
@@ -94,11 +94,55 @@ do { \
 /**
  * log_buf_init() - Initialize htt buffer
  */
-static inline void log_buf_init(struct htt_log_buf_t *buf)
+static inline void log_buf_init(struct htt_log_buf_t *buf, uint32_t entry_size)
 {
-	buf->length = 0;
-	buf->buf_tail_idx = 0;
-	buf->size = HTT_EVENT_DEBUG_MAX_ENTRY;
+	uint32_t i;
+
+	buf->entry_size = entry_size;
+	for (i = 0; i < buf->num_rings; i++)
+		qdf_atomic_init(&buf->ring[i].head);
+}
+
+/**
+ * log_buf_reset() - Drop all records of a htt buffer
+ */
+static inline void log_buf_reset(struct htt_log_buf_t *buf)
+{
+	uint32_t i;
+
+	for (i = 0; i < buf->num_rings; i++) {
+		qdf_mem_zero(buf->ring[i].buf,
+			     HTT_EVENT_DEBUG_CPU_RING_ENTRY * buf->entry_size);
+		qdf_atomic_set(&buf->ring[i].head, 0);
+	}
+}
+
+/**
+ * log_buf_slot_get() - Reserve the next record slot on this CPU's ring
+ * @buf - htt buffer
+ * @cpu_id - Filled with the CPU owning the slot
+ *
+ * Being migrated after reading the CPU id only means the record lands on
+ * another CPU's ring; the atomic reservation keeps the slot private.
+ *
+ * Return: Slot to fill in
+ */
+static inline void *log_buf_slot_get(struct htt_log_buf_t *buf,
+				     uint8_t *cpu_id)
+{
+	struct htt_log_cpu_ring *ring;
+	uint32_t cpu, idx;
+
+	cpu = raw_smp_processor_id();
+	if (qdf_unlikely(cpu >= buf->num_rings))
+		cpu = 0;
+
+	ring = &buf->ring[cpu];
+	idx = qdf_atomic_inc_return(&ring->head) - 1;
+	idx &= HTT_EVENT_DEBUG_CPU_RING_ENTRY - 1;
+	*cpu_id = cpu;
+
+	return (uint8_t *)ring->buf + idx * buf->entry_size;
 }
 
 /**
@@ -111,9 +155,7 @@ int htt_command_record(struct htt_logger *h, uint8_t msg_type,
 		       uint8_t *msg_data)
 {
 	struct htt_command_debug *buf = NULL;
-	uint32_t *p_buf_tail_idx = NULL;
-	uint8_t tdata[HTT_COMMAND_DEBUG_ENTRY_MAX_LENGTH];
-	struct htt_log_buf_t *cmd_log_buf;
+	uint8_t cpu_id;
 
 	/* return 0 if:
 	 * 1. Initialization failed.
@@ -123,34 +165,23 @@ int htt_command_record(struct htt_logger *h, uint8_t msg_type,
 	if (!h)
 		return 0;
 
-	cmd_log_buf = &h->log_info.htt_command_log_buf_info;
 	if ((0 == h->log_info.htt_logging_enable) ||
 	    ((1 << msg_type) & h->log_info.htt_cmd_disable_list))
 		return 0;
 
-	qdf_spin_lock(&cmd_log_buf->record_lock);
-	if (!msg_data) {
-		/* if msg_data is NULL then fill 0xFF in data field */
-		qdf_mem_set(tdata, HTT_COMMAND_DEBUG_ENTRY_MAX_LENGTH, 0xFF);
-		msg_data = tdata;
-	}
-
-	p_buf_tail_idx = &h->log_info.htt_command_log_buf_info.buf_tail_idx;
-
-	/* rewind pointer index if buffer became full */
-	if (HTT_EVENT_DEBUG_MAX_ENTRY <= *p_buf_tail_idx)
-		*p_buf_tail_idx = 0;
-
-	buf = h->log_info.htt_command_log_buf_info.buf;
-	buf[*p_buf_tail_idx].command = msg_type;
-	qdf_mem_copy(buf[*p_buf_tail_idx].data, msg_data,
-		     HTT_COMMAND_DEBUG_ENTRY_MAX_LENGTH);
-	buf[*p_buf_tail_idx].time = qdf_get_log_timestamp();
-	buf[*p_buf_tail_idx].cpu_id = smp_processor_id();
+	buf = log_buf_slot_get(&h->log_info.htt_command_log_buf_info,
+			       &cpu_id);
+	buf->command = msg_type;
+	/* if msg_data is NULL then fill 0xFF in data field */
+	if (!msg_data)
+		qdf_mem_set(buf->data, HTT_COMMAND_DEBUG_ENTRY_MAX_LENGTH,
+			    0xFF);
+	else
+		qdf_mem_copy(buf->data, msg_data,
+			     HTT_COMMAND_DEBUG_ENTRY_MAX_LENGTH);
+	buf->time = qdf_get_log_timestamp();
+	buf->cpu_id = cpu_id;
 
-	(*p_buf_tail_idx)++;
-	h->log_info.htt_command_log_buf_info.length++;
-	qdf_spin_unlock(&cmd_log_buf->record_lock);
 	return 0;
 }
 qdf_export_symbol(htt_command_record);
@@ -164,9 +195,7 @@ qdf_export_symbol(htt_command_record);
 int htt_event_record(struct htt_logger *h, uint8_t msg_type, uint8_t *msg_data)
 {
 	struct htt_event_debug *buf = NULL;
-	uint32_t *p_buf_tail_idx = NULL;
-	uint8_t tdata[HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH];
-	struct htt_log_buf_t *event_log_buf;
+	uint8_t cpu_id;
 
 	/* return 0 if:
 	 * 1. Initialization failed.
@@ -176,34 +205,21 @@ int htt_event_record(struct htt_logger *h, uint8_t msg_type, uint8_t *msg_data)
 	if (!h)
 		return 0;
 
-	event_log_buf = &h->log_info.htt_event_log_buf_info;
 	if ((0 == h->log_info.htt_logging_enable) ||
 	    ((1 << msg_type) & h->log_info.htt_event_disable_list))
 		return 0;
 
-	qdf_spin_lock(&event_log_buf->record_lock);
-	if (!msg_data) {
-		/* if msg_data is NULL then fill 0xFF in data field */
-		qdf_mem_set(tdata, HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH, 0xFF);
-		msg_data = tdata;
-	}
-
-	p_buf_tail_idx = &h->log_info.htt_event_log_buf_info.buf_tail_idx;
-
-	/* rewind pointer index if buffer became full */
-	if (HTT_EVENT_DEBUG_MAX_ENTRY <= *p_buf_tail_idx)
-		*p_buf_tail_idx = 0;
-
-	buf = h->log_info.htt_event_log_buf_info.buf;
-	buf[*p_buf_tail_idx].event = msg_type;
-	qdf_mem_copy(buf[*p_buf_tail_idx].data, msg_data,
-		     HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH);
-	buf[*p_buf_tail_idx].time = qdf_get_log_timestamp();
-	buf[*p_buf_tail_idx].cpu_id = smp_processor_id();
+	buf = log_buf_slot_get(&h->log_info.htt_event_log_buf_info, &cpu_id);
+	buf->event = msg_type;
+	/* if msg_data is NULL then fill 0xFF in data field */
+	if (!msg_data)
+		qdf_mem_set(buf->data, HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH, 0xFF);
+	else
+		qdf_mem_copy(buf->data, msg_data,
+			     HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH);
+	buf->time = qdf_get_log_timestamp();
+	buf->cpu_id = cpu_id;
 
-	(*p_buf_tail_idx)++;
-	h->log_info.htt_event_log_buf_info.length++;
-	qdf_spin_unlock(&event_log_buf->record_lock);
 	return 0;
 }
 
@@ -217,10 +233,8 @@ int htt_event_record(struct htt_logger *h, uint8_t msg_type, uint8_t *msg_data)
 int htt_wbm_event_record(struct htt_logger *h, uint8_t tx_status,
 			 uint8_t *msg_data)
 {
-	uint32_t *p_buf_tail_idx = NULL;
 	struct htt_wbm_event_debug *buf = NULL;
-	uint8_t tdata[HTT_WBM_EVENT_DEBUG_ENTRY_MAX_LENGTH];
-	struct htt_log_buf_t *wbm_event_log_buf;
+	uint8_t cpu_id;
 
 	/* return 0 if:
 	 * 1. Initialization failed.
@@ -231,40 +245,124 @@ int htt_wbm_event_record(struct htt_logger *h, uint8_t tx_status,
 	if (!h)
 		return 0;
 
-	wbm_event_log_buf = &h->log_info.htt_wbm_event_log_buf_info;
 	if ((0 == h->log_info.htt_logging_enable) ||
 	    ((1 << tx_status) & h->log_info.htt_wbm_event_disable_list))
 		return 0;
 
-	qdf_spin_lock(&wbm_event_log_buf->record_lock);
-	if (!msg_data) {
-		/* if msg_data is NULL then fill 0xFF in data field */
-		qdf_mem_set(tdata, HTT_WBM_EVENT_DEBUG_ENTRY_MAX_LENGTH, 0xFF);
-		msg_data = tdata;
+	buf = log_buf_slot_get(&h->log_info.htt_wbm_event_log_buf_info,
+			       &cpu_id);
+	buf->tx_status = tx_status;
+	/* if msg_data is NULL then fill 0xFF in data field */
+	if (!msg_data)
+		qdf_mem_set(buf->data, HTT_WBM_EVENT_DEBUG_ENTRY_MAX_LENGTH,
+			    0xFF);
+	else
+		qdf_mem_copy(buf->data, msg_data,
+			     HTT_WBM_EVENT_DEBUG_ENTRY_MAX_LENGTH);
+	buf->time = qdf_get_log_timestamp();
+	buf->cpu_id = cpu_id;
+
+	return 0;
+}
+
+/**
+ * struct htt_log_iter - Newest first walk over all CPU rings of a buffer
+ * @buf - htt buffer being walked
+ * @time_off - Offset of the uint64_t timestamp within a record
+ * @head - Per ring head snapshot taken at init
+ * @taken - Per ring count of records already returned
+ * @length - Total records logged at snapshot time
+ */
+struct htt_log_iter {
+	struct htt_log_buf_t *buf;
+	size_t time_off;
+	uint32_t *head;
+	uint32_t *taken;
+	uint32_t length;
+};
+
+/**
+ * htt_log_iter_init() - Snapshot the ring heads of a htt buffer
+ * @it - Iterator to set up
+ * @h - htt logger handle
+ * @buf - htt buffer to walk
+ * @time_off - Offset of the timestamp within a record
+ *
+ * Return: QDF_STATUS_SUCCESS or QDF_STATUS_E_NOMEM
+ */
+static QDF_STATUS htt_log_iter_init(struct htt_log_iter *it,
+				    struct htt_logger *h,
+				    struct htt_log_buf_t *buf, size_t time_off)
+{
+	uint32_t i;
+
+	it->head = qdf_mem_malloc(2 * buf->num_rings * sizeof(uint32_t));
+	if (!it->head)
+		return QDF_STATUS_E_NOMEM;
+
+	it->taken = it->head + buf->num_rings;
+	it->buf = buf;
+	it->time_off = time_off;
+	it->length = 0;
+
+	qdf_spin_lock(&h->log_info.htt_record_lock);
+	for (i = 0; i < buf->num_rings; i++) {
+		it->head[i] = qdf_atomic_read(&buf->ring[i].head);
+		it->length += it->head[i];
+	}
+	qdf_spin_unlock(&h->log_info.htt_record_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * htt_log_iter_next() - Return the newest record not yet returned
+ * @it - Iterator
+ *
+ * Each CPU ring is already in time order, so this is a merge of the ring
+ * tails by timestamp.
+ *
+ * Return: Record or NULL once all rings are exhausted
+ */
+static void *htt_log_iter_next(struct htt_log_iter *it)
+{
+	struct htt_log_buf_t *buf = it->buf;
+	uint8_t *rec, *best = NULL;
+	uint64_t best_time = 0, time;
+	uint32_t i, best_ring = 0, idx;
+
+	for (i = 0; i < buf->num_rings; i++) {
+		if (it->taken[i] >= qdf_min(it->head[i],
+				(uint32_t)HTT_EVENT_DEBUG_CPU_RING_ENTRY))
+			continue;
+
+		idx = (it->head[i] - 1 - it->taken[i]) &
+		      (HTT_EVENT_DEBUG_CPU_RING_ENTRY - 1);
+		rec = (uint8_t *)buf->ring[i].buf + idx * buf->entry_size;
+		time = *(uint64_t *)(rec + it->time_off);
+		if (!best || time > best_time) {
+			best = rec;
+			best_time = time;
+			best_ring = i;
+		}
 	}
 
-	p_buf_tail_idx = &h->log_info.htt_wbm_event_log_buf_info.buf_tail_idx;
-	if (HTT_EVENT_DEBUG_MAX_ENTRY <= *p_buf_tail_idx)
-		*p_buf_tail_idx = 0;
+	if (best)
+		it->taken[best_ring]++;
 
-	buf = h->log_info.htt_wbm_event_log_buf_info.buf;
-	buf[*p_buf_tail_idx].tx_status = tx_status;
-	qdf_mem_copy(buf[*p_buf_tail_idx].data, msg_data,
-		     HTT_WBM_EVENT_DEBUG_ENTRY_MAX_LENGTH);
-	buf[*p_buf_tail_idx].time = qdf_get_log_timestamp();
-	buf[*p_buf_tail_idx].cpu_id = smp_processor_id();
+	return best;
+}
 
-	(*p_buf_tail_idx)++;
-	h->log_info.htt_wbm_event_log_buf_info.length++;
-	qdf_spin_unlock(&wbm_event_log_buf->record_lock);
-	return 0;
+static inline void htt_log_iter_deinit(struct htt_log_iter *it)
+{
+	qdf_mem_free(it->head);
 }
 
 /* debugfs routines */
 /**
  * debug_htt_command_log_show() - debugfs functions to display content of
- * command and event buffers. Macro uses max buffer length to display
- * buffer when it is wraparound.
+ * command and event buffers. The most recent HTT_DISPLAY_SIZE records are
+ * shown newest first, merged across the per CPU rings by timestamp.
  *
  * @m: qdf_debugfs handler to access htt_logger_handle
  * @arg: Private data htt_logger_hand here
@@ -276,36 +374,27 @@ static QDF_STATUS debug_htt_command_log_show(qdf_debugfs_file_t file, void *arg)
 {
 	struct htt_logger *htt_logger_handle = (struct htt_logger *)arg;
 	struct htt_log_buf_t *htt_log = NULL;
-	int pos, nread, i;
+	struct htt_command_debug *htt_record;
+	struct htt_log_iter it;
+	int nread, i;
 	uint64_t secs, usecs;
 
 	htt_log = &htt_logger_handle->log_info.htt_command_log_buf_info;
 
-	qdf_spin_lock(&htt_logger_handle->log_info.htt_record_lock);
-	if (!htt_log->length) {
-		qdf_spin_unlock(&htt_logger_handle->log_info.htt_record_lock);
+	if (htt_log_iter_init(&it, htt_logger_handle, htt_log,
+			      offsetof(struct htt_command_debug, time)))
+		return QDF_STATUS_E_NOMEM;
+
+	if (!it.length) {
+		htt_log_iter_deinit(&it);
 		qdf_debugfs_printf(file,
 				   "no elements to read from ring buffer!\n");
 		return QDF_STATUS_SUCCESS;
 	}
 
-	if (htt_log->length <= HTT_DISPLAY_SIZE)
-		nread = htt_log->length;
-	else
-		nread = HTT_DISPLAY_SIZE;
-
-	if (htt_log->buf_tail_idx == 0)
-		pos = HTT_DISPLAY_SIZE - 1;
-	else
-		pos = htt_log->buf_tail_idx - 1;
-
-	qdf_debugfs_printf(file, "Length = %d\n", htt_log->length);
-	qdf_spin_unlock(&htt_logger_handle->log_info.htt_record_lock);
-	while (nread--) {
-		struct htt_command_debug *htt_record;
-
-		htt_record = (struct htt_command_debug *)
-		&(((struct htt_command_debug *)htt_log->buf)[pos]);
+	qdf_debugfs_printf(file, "Length = %d\n", it.length);
+	nread = HTT_DISPLAY_SIZE;
+	while (nread-- && (htt_record = htt_log_iter_next(&it))) {
 		qdf_debugfs_printf(file, "CMD ID = %x\n",
 				   htt_record->command);
 		qdf_debugfs_printf(file, "DATA[0-%d]:",
@@ -317,12 +406,9 @@ static QDF_STATUS debug_htt_command_log_show(qdf_debugfs_file_t file, void *arg)
 		qdf_debugfs_printf(file, "\nCPU ID = %d", htt_record->cpu_id);
 		qdf_debugfs_printf(file, "\nCMD TIME = [%llu.%06llu]\n",
 				   secs, usecs);
-
-		if (pos == 0)
-			pos = HTT_DISPLAY_SIZE - 1;
-		else
-			pos--;
 	}
+	htt_log_iter_deinit(&it);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -330,36 +416,27 @@ static QDF_STATUS debug_htt_event_log_show(qdf_debugfs_file_t file, void *arg)
 {
 	struct htt_logger *htt_logger_handle = (struct htt_logger *)arg;
 	struct htt_log_buf_t *htt_log = NULL;
-	int pos, nread, i;
+	struct htt_event_debug *htt_record;
+	struct htt_log_iter it;
+	int nread, i;
 	uint64_t secs, usecs;
 
 	htt_log = &htt_logger_handle->log_info.htt_event_log_buf_info;
 
-	qdf_spin_lock(&htt_logger_handle->log_info.htt_record_lock);
-	if (!htt_log->length) {
-		qdf_spin_unlock(&htt_logger_handle->log_info.htt_record_lock);
+	if (htt_log_iter_init(&it, htt_logger_handle, htt_log,
+			      offsetof(struct htt_event_debug, time)))
+		return QDF_STATUS_E_NOMEM;
+
+	if (!it.length) {
+		htt_log_iter_deinit(&it);
 		qdf_debugfs_printf(file,
 				   "no elements to read from ring buffer!\n");
 		return QDF_STATUS_SUCCESS;
 	}
 
-	if (htt_log->length <= HTT_DISPLAY_SIZE)
-		nread = htt_log->length;
-	else
-		nread = HTT_DISPLAY_SIZE;
-
-	if (htt_log->buf_tail_idx == 0)
-		pos = HTT_DISPLAY_SIZE - 1;
-	else
-		pos = htt_log->buf_tail_idx - 1;
-
-	qdf_debugfs_printf(file, "Length = %d\n", htt_log->length);
-	qdf_spin_unlock(&htt_logger_handle->log_info.htt_record_lock);
-	while (nread--) {
-		struct htt_event_debug *htt_record;
-
-		htt_record = (struct htt_event_debug *)
-		&(((struct htt_event_debug *)htt_log->buf)[pos]);
+	qdf_debugfs_printf(file, "Length = %d\n", it.length);
+	nread = HTT_DISPLAY_SIZE;
+	while (nread-- && (htt_record = htt_log_iter_next(&it))) {
 		qdf_debugfs_printf(file, "EVENT ID = %x\n", htt_record->event);
 		qdf_debugfs_printf(file, "DATA[0 - %d]:",
 				   HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH - 1);
@@ -370,12 +447,9 @@ static QDF_STATUS debug_htt_event_log_show(qdf_debugfs_file_t file, void *arg)
 		qdf_debugfs_printf(file, "\nCPU ID = %d", (htt_record->cpu_id));
 		qdf_debugfs_printf(file, "\nEVENT TIME = [%llu.%06llu]\n",
 				   secs, usecs);
-
-		if (pos == 0)
-			pos = HTT_DISPLAY_SIZE - 1;
-		else
-			pos--;
 	}
+	htt_log_iter_deinit(&it);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -384,36 +458,27 @@ static QDF_STATUS debug_htt_wbm_event_log_show(qdf_debugfs_file_t file,
 {
 	struct htt_logger *htt_logger_handle = (struct htt_logger *)arg;
 	struct htt_log_buf_t *htt_log = NULL;
-	int pos, nread, i;
+	struct htt_wbm_event_debug *htt_record;
+	struct htt_log_iter it;
+	int nread, i;
 	uint64_t secs, usecs;
 
 	htt_log = &htt_logger_handle->log_info.htt_wbm_event_log_buf_info;
 
-	qdf_spin_lock(&htt_logger_handle->log_info.htt_record_lock);
-	if (!htt_log->length) {
-		qdf_spin_unlock(&htt_logger_handle->log_info.htt_record_lock);
+	if (htt_log_iter_init(&it, htt_logger_handle, htt_log,
+			      offsetof(struct htt_wbm_event_debug, time)))
+		return QDF_STATUS_E_NOMEM;
+
+	if (!it.length) {
+		htt_log_iter_deinit(&it);
 		qdf_debugfs_printf(file,
 				   "no elements to read from ring buffer!\n");
 		return QDF_STATUS_SUCCESS;
 	}
 
-	if (htt_log->length <= HTT_DISPLAY_SIZE)
-		nread = htt_log->length;
-	else
-		nread = HTT_DISPLAY_SIZE;
-
-	if (htt_log->buf_tail_idx == 0)
-		pos = HTT_DISPLAY_SIZE - 1;
-	else
-		pos = htt_log->buf_tail_idx - 1;
-
-	qdf_debugfs_printf(file, "Length = %d\n", htt_log->length);
-	qdf_spin_unlock(&htt_logger_handle->log_info.htt_record_lock);
-	while (nread--) {
-		struct htt_wbm_event_debug *htt_record;
-
-		htt_record = (struct htt_wbm_event_debug *)
-		&(((struct htt_wbm_event_debug *)htt_log->buf)[pos]);
+	qdf_debugfs_printf(file, "Length = %d\n", it.length);
+	nread = HTT_DISPLAY_SIZE;
+	while (nread-- && (htt_record = htt_log_iter_next(&it))) {
 		qdf_debugfs_printf(file, "WBM Event Tx status =  = %x\n",
 				   htt_record->tx_status);
 		qdf_debugfs_printf(file, "DATA[0-%d]:",
@@ -425,16 +490,104 @@ static QDF_STATUS debug_htt_wbm_event_log_show(qdf_debugfs_file_t file,
 		qdf_debugfs_printf(file, "\nCPU ID = %d", (htt_record->cpu_id));
 		qdf_debugfs_printf(file, "\nWBM EVENT TIME = [%llu.%06llu]\n",
 				   secs, usecs);
+	}
+	htt_log_iter_deinit(&it);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * htt_log_bin_dump() - Emit every record of one htt buffer as packed
+ * struct htt_log_bin_record, newest first
+ * @file: qdf debugfs handler
+ * @h: htt logger handle
+ * @type: HTT_LOG_BIN_* type of @buf
+ * @buf: htt buffer
+ * @time_off: offset of the timestamp within a record of @buf
+ *
+ * Return: Status
+ */
+static QDF_STATUS htt_log_bin_dump(qdf_debugfs_file_t file,
+				   struct htt_logger *h, uint8_t type,
+				   struct htt_log_buf_t *buf, size_t time_off)
+{
+	struct htt_log_bin_record bin;
+	struct htt_command_debug *cmd;
+	struct htt_event_debug *event;
+	struct htt_wbm_event_debug *wbm;
+	struct htt_log_iter it;
+	void *rec;
+
+	if (htt_log_iter_init(&it, h, buf, time_off))
+		return QDF_STATUS_E_NOMEM;
 
-		if (pos == 0)
-			pos = HTT_DISPLAY_SIZE - 1;
-		else
-			pos--;
+	bin.type = type;
+	bin.len = HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH;
+	while ((rec = htt_log_iter_next(&it))) {
+		switch (type) {
+		case HTT_LOG_BIN_COMMAND:
+			cmd = rec;
+			bin.id = cmd->command;
+			bin.cpu_id = cmd->cpu_id;
+			bin.time = qdf_cpu_to_le64(cmd->time);
+			qdf_mem_copy(bin.data, cmd->data, bin.len);
+			break;
+		case HTT_LOG_BIN_EVENT:
+			event = rec;
+			bin.id = event->event;
+			bin.cpu_id = event->cpu_id;
+			bin.time = qdf_cpu_to_le64(event->time);
+			qdf_mem_copy(bin.data, event->data, bin.len);
+			break;
+		default:
+			wbm = rec;
+			bin.id = wbm->tx_status;
+			bin.cpu_id = wbm->cpu_id;
+			bin.time = qdf_cpu_to_le64(wbm->time);
+			qdf_mem_copy(bin.data, wbm->data, bin.len);
+			break;
+		}
+		qdf_debugfs_write(file, (uint8_t *)&bin, sizeof(bin));
 	}
+	htt_log_iter_deinit(&it);
 
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * debug_htt_log_bin_show() - debugfs function to dump all command, event
+ * and wbm event records in the packed struct htt_log_bin_record format
+ * for offline decoding.
+ *
+ * @file: qdf debugfs handler
+ * @arg: priv data used to get htt_logger_handler
+ *
+ * Return: Status
+ */
+static QDF_STATUS debug_htt_log_bin_show(qdf_debugfs_file_t file, void *arg)
+{
+	struct htt_logger *htt_logger_handle = (struct htt_logger *)arg;
+	struct htt_debug_log_info *log_info_p = &htt_logger_handle->log_info;
+	QDF_STATUS status;
+
+	status = htt_log_bin_dump(file, htt_logger_handle, HTT_LOG_BIN_COMMAND,
+				  &log_info_p->htt_command_log_buf_info,
+				  offsetof(struct htt_command_debug, time));
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	status = htt_log_bin_dump(file, htt_logger_handle, HTT_LOG_BIN_EVENT,
+				  &log_info_p->htt_event_log_buf_info,
+				  offsetof(struct htt_event_debug, time));
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	return htt_log_bin_dump(file, htt_logger_handle,
+				HTT_LOG_BIN_WBM_EVENT,
+				&log_info_p->htt_wbm_event_log_buf_info,
+				offsetof(struct htt_wbm_event_debug, time));
+}
+
 /**
  * debug_htt_enable_show() - debugfs functions to display enable state of
  * htt logging feature.
@@ -528,8 +681,12 @@ static QDF_STATUS debug_htt_wbm_event_disable_list_show(qdf_debugfs_file_t file
  */
 static QDF_STATUS debug_htt_log_size_show(qdf_debugfs_file_t file, void *arg)
 {
-	qdf_debugfs_printf(file, "HTT command/event log max size:%d\n",
-			   HTT_EVENT_DEBUG_MAX_ENTRY);
+	struct htt_logger *htt_logger_handle = (struct htt_logger *)arg;
+
+	qdf_debugfs_printf(file, "HTT command/event log max size:%d x %d CPUs\n",
+			   HTT_EVENT_DEBUG_CPU_RING_ENTRY,
+			   htt_logger_handle->log_info.
+			   htt_command_log_buf_info.num_rings);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -544,7 +701,7 @@ static QDF_STATUS debug_htt_log_size_show(qdf_debugfs_file_t file, void *arg)
  *
  * Return: Status
  */
-#define GENERATE_DEBUG_WRITE_FUNCS(func_base, htt_ring_size, htt_record_type) \
+#define GENERATE_DEBUG_WRITE_FUNCS(func_base)                                 \
 	static QDF_STATUS debug_htt_##func_base##_write(void *priv,           \
 			const char *buf, qdf_size_t len)                      \
 {                                                                             \
@@ -557,20 +714,14 @@ static QDF_STATUS debug_htt_log_size_show(qdf_debugfs_file_t file, void *arg)
 		return QDF_STATUS_E_PERM;                                     \
 	}                                                                     \
 	qdf_spin_lock(&htt_logger_handle->log_info.htt_record_lock);          \
-	qdf_mem_zero(htt_log->buf, (htt_ring_size) *                          \
-			sizeof(struct htt_record_type));                      \
-	htt_log->length = 0;                                                  \
-	htt_log->buf_tail_idx = 0;                                       \
+	log_buf_reset(htt_log);                                               \
 	qdf_spin_unlock(&htt_logger_handle->log_info.htt_record_lock);        \
 	return QDF_STATUS_SUCCESS ;                                           \
 }
 
-GENERATE_DEBUG_WRITE_FUNCS(command_log, HTT_EVENT_DEBUG_MAX_ENTRY,
-			   htt_command_debug);
-GENERATE_DEBUG_WRITE_FUNCS(event_log, HTT_EVENT_DEBUG_MAX_ENTRY,
-			   htt_event_debug);
-GENERATE_DEBUG_WRITE_FUNCS(wbm_event_log, HTT_EVENT_DEBUG_MAX_ENTRY,
-			   htt_wbm_event_debug);
+GENERATE_DEBUG_WRITE_FUNCS(command_log);
+GENERATE_DEBUG_WRITE_FUNCS(event_log);
+GENERATE_DEBUG_WRITE_FUNCS(wbm_event_log);
 
 /**
  * debug_htt_enable_write() - debugfs functions to enable/disable
@@ -687,6 +838,22 @@ static QDF_STATUS debug_htt_log_size_write(void *priv,
 	return -EINVAL;
 }
 
+/**
+ * debug_htt_log_bin_write() - reserved.
+ *
+ * @priv: file handler to access htt_logger_handle
+ * @buf: received data buffer
+ * @len: length of received buffer
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS debug_htt_log_bin_write(void *priv,
+					  const char *buf,
+					  qdf_size_t len)
+{
+	return -EINVAL;
+}
+
 /* Structure to maintain debug information */
 struct htt_debugfs_info {
 	const char *name;
@@ -712,6 +879,7 @@ GENERATE_DEBUG_STRUCTS(htt_log_size);
 GENERATE_DEBUG_STRUCTS(htt_cmd_disable_list);
 GENERATE_DEBUG_STRUCTS(htt_event_disable_list);
 GENERATE_DEBUG_STRUCTS(htt_wbm_event_disable_list);
+GENERATE_DEBUG_STRUCTS(htt_log_bin);
 
 struct htt_debugfs_info htt_debugfs_infos[NUM_HTT_DEBUG_INFOS] = {
 	DEBUGFS_FOPS(htt_command_log),
@@ -722,8 +890,63 @@ struct htt_debugfs_info htt_debugfs_infos[NUM_HTT_DEBUG_INFOS] = {
 	DEBUGFS_FOPS(htt_cmd_disable_list),
 	DEBUGFS_FOPS(htt_event_disable_list),
 	DEBUGFS_FOPS(htt_wbm_event_disable_list),
+	DEBUGFS_FOPS(htt_log_bin),
 };
 
+/**
+ * log_buf_free() - Free the per CPU rings of one htt buffer
+ * @buf: htt buffer
+ *
+ * Return: None
+ */
+static void log_buf_free(struct htt_log_buf_t *buf)
+{
+	uint32_t i;
+
+	if (!buf->ring)
+		return;
+
+	for (i = 0; i < buf->num_rings; i++) {
+		if (buf->ring[i].buf)
+			qdf_mem_free(buf->ring[i].buf);
+	}
+	qdf_mem_free(buf->ring);
+	buf->ring = NULL;
+	buf->num_rings = 0;
+}
+
+/**
+ * log_buf_alloc() - Allocate one ring per possible CPU for a htt buffer
+ * @buf: htt buffer
+ * @entry_size: size of one record
+ *
+ * Return: QDF_STATUS_SUCCESS or QDF_STATUS_E_NOMEM
+ */
+static QDF_STATUS log_buf_alloc(struct htt_log_buf_t *buf, uint32_t entry_size)
+{
+	uint32_t i;
+
+	buf->num_rings = nr_cpu_ids;
+	buf->ring = qdf_mem_malloc(buf->num_rings * sizeof(*buf->ring));
+	if (!buf->ring) {
+		buf->num_rings = 0;
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	for (i = 0; i < buf->num_rings; i++) {
+		buf->ring[i].buf =
+			qdf_mem_malloc(HTT_EVENT_DEBUG_CPU_RING_ENTRY *
+				       entry_size);
+		if (!buf->ring[i].buf) {
+			log_buf_free(buf);
+			return QDF_STATUS_E_NOMEM;
+		}
+	}
+
+	log_buf_init(buf, entry_size);
+	return QDF_STATUS_SUCCESS;
+}
+
 /**
  * htt_log_buffer_free() - Free all dynamic allocated buffer memory for
  * event logging
@@ -739,18 +962,9 @@ static inline void htt_log_buffer_free(struct htt_logger *htt_logger_handle)
 	log_info_p->htt_logging_enable = 0;
 
 	/* Free allocated buffer */
-	if (log_info_p->htt_command_log_buf_info.buf) {
-		qdf_mem_free(log_info_p->htt_command_log_buf_info.buf);
-		log_info_p->htt_command_log_buf_info.buf = NULL;
-	}
-	if (log_info_p->htt_event_log_buf_info.buf) {
-		qdf_mem_free(log_info_p->htt_event_log_buf_info.buf);
-		log_info_p->htt_event_log_buf_info.buf = NULL;
-	}
-	if (log_info_p->htt_wbm_event_log_buf_info.buf) {
-		qdf_mem_free(log_info_p->htt_wbm_event_log_buf_info.buf);
-		log_info_p->htt_wbm_event_log_buf_info.buf = NULL;
-	}
+	log_buf_free(&log_info_p->htt_command_log_buf_info);
+	log_buf_free(&log_info_p->htt_event_log_buf_info);
+	log_buf_free(&log_info_p->htt_wbm_event_log_buf_info);
 }
 
 /**
@@ -777,24 +991,16 @@ static QDF_STATUS htt_log_buffer_alloc(struct htt_logger *htt_logger_handle)
 	htt_logger_handle->log_info.htt_logging_enable = 0;
 
 	/* Allocate data buffer */
-	cmd_log_buf->buf = (struct htt_command_debug *)qdf_mem_malloc(
-				HTT_EVENT_DEBUG_MAX_ENTRY *
-				sizeof(struct htt_command_debug));
-	if (!cmd_log_buf->buf) {
+	if (log_buf_alloc(cmd_log_buf, sizeof(struct htt_command_debug))) {
 		HTT_LOGE("Memory allocation for HTT CMD log failed.");
 		goto error_mem_fail;
 	}
-	event_log_buf->buf = (struct htt_event_debug *)qdf_mem_malloc(
-				HTT_EVENT_DEBUG_MAX_ENTRY *
-				sizeof(struct htt_event_debug));
-	if (!event_log_buf->buf) {
+	if (log_buf_alloc(event_log_buf, sizeof(struct htt_event_debug))) {
 		HTT_LOGE("Memory allocation for HTT EVENT log failed.");
 		goto error_mem_fail;
 	}
-	wbm_event_log_buf->buf = (struct htt_wbm_event_debug *)qdf_mem_malloc(
-					HTT_EVENT_DEBUG_MAX_ENTRY *
-					sizeof(struct htt_wbm_event_debug));
-	if (!wbm_event_log_buf->buf) {
+	if (log_buf_alloc(wbm_event_log_buf,
+			  sizeof(struct htt_wbm_event_debug))) {
 		HTT_LOGE("Memory allocation for HTT WBM EVENT log failed.");
 		goto error_mem_fail;
 	}
@@ -806,24 +1012,13 @@ error_mem_fail:
 }
 
 /**
- * htt_log_lock_free - Destroy lock
+ * htt_log_lock_alloc - Create lock
  */
 static inline void htt_log_lock_alloc(struct htt_logger *htt_logger_handle)
 {
 	struct htt_debug_log_info *log_info_p = &htt_logger_handle->log_info;
-	struct htt_log_buf_t *cmd_log_buf =
-		&htt_logger_handle->log_info.htt_command_log_buf_info;
-	struct htt_log_buf_t *event_log_buf =
-		&htt_logger_handle->log_info.htt_event_log_buf_info;
-	struct htt_log_buf_t *wbm_event_log_buf =
-		&htt_logger_handle->log_info.htt_wbm_event_log_buf_info;
 
-	/* Create lock for cmd/event/wbm */
-	qdf_spinlock_create(&cmd_log_buf->record_lock);
-	qdf_spinlock_create(&event_log_buf->record_lock);
-	qdf_spinlock_create(&wbm_event_log_buf->record_lock);
-
-	/* Create recording lock in read through debugfs */
+	/* Create lock serializing debugfs reads and clears */
 	qdf_spinlock_create(&log_info_p->htt_record_lock);
 }
 
@@ -833,19 +1028,8 @@ static inline void htt_log_lock_alloc(struct htt_logger *htt_logger_handle)
 static inline void htt_log_lock_free(struct htt_logger *htt_logger_handle)
 {
 	struct htt_debug_log_info *log_info_p = &htt_logger_handle->log_info;
-	struct htt_log_buf_t *cmd_log_buf =
-		&htt_logger_handle->log_info.htt_command_log_buf_info;
-	struct htt_log_buf_t *event_log_buf =
-		&htt_logger_handle->log_info.htt_event_log_buf_info;
-	struct htt_log_buf_t *wbm_event_log_buf =
-		&htt_logger_handle->log_info.htt_wbm_event_log_buf_info;
-
-	/* Destroy lock for cmd/event/wbm */
-	qdf_spinlock_destroy(&cmd_log_buf->record_lock);
-	qdf_spinlock_destroy(&event_log_buf->record_lock);
-	qdf_spinlock_destroy(&wbm_event_log_buf->record_lock);
 
-	/* Destroy recording lock in read through debugfs */
+	/* Destroy lock serializing debugfs reads and clears */
 	qdf_spinlock_destroy(&log_info_p->htt_record_lock);
 }
 
@@ -926,9 +1110,6 @@ void htt_interface_logging_init(struct htt_logger **phtt_logger_handle,
 {
 	QDF_STATUS ret;
 	struct htt_logger *htt_logger_handle;
-	struct htt_log_buf_t *cmd_log_buf;
-	struct htt_log_buf_t *event_log_buf;
-	struct htt_log_buf_t *wbm_event_log_buf;
 	uint64_t htt_disable_mask;
 	struct wlan_objmgr_psoc *psoc;
 
@@ -945,17 +1126,6 @@ void htt_interface_logging_init(struct htt_logger **phtt_logger_handle,
 		return;
 	}
 	htt_logger_handle = *phtt_logger_handle;
-	cmd_log_buf =
-		&htt_logger_handle->log_info.htt_command_log_buf_info;
-	event_log_buf =
-		&htt_logger_handle->log_info.htt_event_log_buf_info;
-	wbm_event_log_buf =
-		&htt_logger_handle->log_info.htt_wbm_event_log_buf_info;
-
-	/* Initialize HTT Cmd/Event/WBM Event */
-	log_buf_init(cmd_log_buf);
-	log_buf_init(event_log_buf);
-	log_buf_init(wbm_event_log_buf);
 
 	/**
 	 * Disable all command except:
@@ -25,10 +25,25 @@
 #define HTT_EVENT_DEBUG_MAX_ENTRY (1024)
 #endif
 
+/*
+ * Entries per CPU ring, must be a power of 2. The default keeps the total
+ * close to HTT_EVENT_DEBUG_MAX_ENTRY on a quad core host.
+ */
+#ifndef HTT_EVENT_DEBUG_CPU_RING_ENTRY
+#define HTT_EVENT_DEBUG_CPU_RING_ENTRY (HTT_EVENT_DEBUG_MAX_ENTRY / 4)
+#endif
+
+#if (HTT_EVENT_DEBUG_CPU_RING_ENTRY & (HTT_EVENT_DEBUG_CPU_RING_ENTRY - 1))
+#error "HTT_EVENT_DEBUG_CPU_RING_ENTRY must be a power of 2"
+#endif
+
+/* Record slots are padded to this size so that writers never share a line */
+#define HTT_LOG_SLOT_ALIGN 64
+
 #define HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH (32)
 #define HTT_COMMAND_DEBUG_ENTRY_MAX_LENGTH (32)
 #define HTT_WBM_EVENT_DEBUG_ENTRY_MAX_LENGTH (32)
-#define NUM_HTT_DEBUG_INFOS 8
+#define NUM_HTT_DEBUG_INFOS 9
 
 #define HTT_LOGD(args ...) \
 	QDF_TRACE(QDF_MODULE_ID_HTT, QDF_TRACE_LEVEL_DEBUG, ## args)
@@ -54,7 +69,7 @@ struct htt_command_debug {
 	uint8_t data[HTT_COMMAND_DEBUG_ENTRY_MAX_LENGTH];
 	uint64_t time;
 	uint8_t cpu_id;
-};
+} qdf_aligned(HTT_LOG_SLOT_ALIGN);
 
 /**
  * struct htt_event_debug - HTT event log buffer data type
@@ -68,7 +83,7 @@ struct htt_event_debug {
 	uint8_t data[HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH];
 	uint64_t time;
 	uint8_t cpu_id;
-};
+} qdf_aligned(HTT_LOG_SLOT_ALIGN);
 
 /**
  * struct htt_wbm_event_debug - HTT wbm event log buffer data type
@@ -82,32 +97,65 @@ struct htt_wbm_event_debug {
 	uint8_t data[HTT_WBM_EVENT_DEBUG_ENTRY_MAX_LENGTH];
 	uint64_t time;
 	uint8_t cpu_id;
-};
+} qdf_aligned(HTT_LOG_SLOT_ALIGN);
 
 /**
- * struct htt_log_buf_t - HTT log buffer information type
- * @buf - Refernce to HTT log buffer
- * @ length - total count of command/event logged
- * @ buf_tail_idx - Tail index of buffer
- * @ size - the size of the buffer in number of entries
- * @record_lock - Lock HTT recording separate for all cmd/event/wbm
+ * struct htt_log_cpu_ring - Per CPU HTT log ring
+ * @head - Number of records ever reserved on this ring. A writer reserves
+ *         its slot with an atomic increment, so concurrent writers on the
+ *         same CPU (task and softirq) never share a slot and no lock is
+ *         needed. Each ring sits on its own cache line.
+ * @buf - HTT_EVENT_DEBUG_CPU_RING_ENTRY records
  */
-struct htt_log_buf_t {
+struct htt_log_cpu_ring {
+	qdf_atomic_t head;
 	void *buf;
-	uint32_t length;
-	uint32_t buf_tail_idx;
-	uint32_t size;
+} qdf_aligned(HTT_LOG_SLOT_ALIGN);
 
-	qdf_spinlock_t record_lock;
+/**
+ * struct htt_log_buf_t - HTT log buffer information type
+ * @ring - Array of per CPU rings, one per possible CPU id
+ * @num_rings - Number of entries in @ring
+ * @entry_size - Size of one record in bytes
+ */
+struct htt_log_buf_t {
+	struct htt_log_cpu_ring *ring;
+	uint32_t num_rings;
+	uint32_t entry_size;
 };
 
+/**
+ * struct htt_log_bin_record - Record layout of the htt_log_bin debugfs file
+ * @type - HTT_LOG_BIN_{COMMAND,EVENT,WBM_EVENT}
+ * @id - Command id, event id or WBM tx status
+ * @cpu_id - CPU which logged the record
+ * @len - Number of valid bytes in @data
+ * @time - qdf_get_log_timestamp() at record time, little endian
+ * @data - Logged message data
+ *
+ * The file is a plain sequence of these packed records, so it can be
+ * copied off target and decoded offline.
+ */
+struct htt_log_bin_record {
+	uint8_t type;
+	uint8_t id;
+	uint8_t cpu_id;
+	uint8_t len;
+	uint64_t time;
+	uint8_t data[HTT_EVENT_DEBUG_ENTRY_MAX_LENGTH];
+} qdf_packed;
+
+#define HTT_LOG_BIN_COMMAND 0
+#define HTT_LOG_BIN_EVENT 1
+#define HTT_LOG_BIN_WBM_EVENT 2
+
 /**
  * struct htt_debug_log_info - Meta data to hold information of
  *                             all buffers used for HTT logging
  * @htt_command_log_buf_info - Buffer info for HTT Command log
  * @htt_event_log_buf_info - Buffer info for HTT Event log
  * @htt_wbm_event_log_buf_info - Buffer info for HTT wbm event log
- * @htt_record_lock - Lock HTT recording (while reading through debugfs)
+ * @htt_record_lock - Serialize debugfs readers and buffer clears
  * @htt_logging_enable - Enable/Disable state for HTT logging
  * @htt_cmd_disable_list - Enable/Disable logging for some
  *                           specific cmd(BitMap)
@@ -25,6 +25,68 @@
 #define DP_MSCS_INVALID_TID 0xFF
 #define DP_MSCS_VALID_TID_MASK 0x7
 
+/* source peer cache size, must be a power of 2 */
+#define DP_MSCS_PEER_CACHE_SIZE 256
+#define DP_MSCS_PEER_CACHE_IDX(_mac) \
+	(((_mac)[3] ^ (_mac)[4] ^ (_mac)[5]) & (DP_MSCS_PEER_CACHE_SIZE - 1))
+
+/**
+ * struct dp_mscs_peer_cache - last peer resolved for a source mac
+ * @soc: soc the peer belongs to
+ * @mac_addr: source mac address
+ * @peer_id: peer id resolved for @mac_addr
+ *
+ * Entries are only hints: they are written without locking and a hit
+ * is trusted only after the peer taken by id is found to carry the
+ * looked up mac address, so a stale or torn entry costs a fallback to
+ * the peer hash lookup and never a wrong classification.
+ */
+struct dp_mscs_peer_cache {
+	struct dp_soc *soc;
+	uint8_t mac_addr[QDF_MAC_ADDR_SIZE];
+	uint16_t peer_id;
+};
+
+static struct dp_mscs_peer_cache dp_mscs_peer_cache[DP_MSCS_PEER_CACHE_SIZE];
+
+/**
+ * dp_mscs_src_peer_get() - Get reference of the peer for a source mac
+ * @soc - DP soc
+ * @src_mac_addr - src mac address from connection
+ *
+ * Return: peer with DP_MOD_ID_MSCS reference held, NULL if not found
+ */
+static struct dp_peer *dp_mscs_src_peer_get(struct dp_soc *soc,
+					    uint8_t *src_mac_addr)
+{
+	struct dp_mscs_peer_cache *entry;
+	struct dp_peer *peer;
+
+	entry = &dp_mscs_peer_cache[DP_MSCS_PEER_CACHE_IDX(src_mac_addr)];
+	if (entry->soc == soc &&
+	    !qdf_mem_cmp(entry->mac_addr, src_mac_addr, QDF_MAC_ADDR_SIZE)) {
+		peer = dp_peer_get_ref_by_id(soc, entry->peer_id,
+					     DP_MOD_ID_MSCS);
+		if (peer) {
+			if (!qdf_mem_cmp(peer->mac_addr.raw, src_mac_addr,
+					 QDF_MAC_ADDR_SIZE))
+				return peer;
+
+			dp_peer_unref_delete(peer, DP_MOD_ID_MSCS);
+		}
+	}
+
+	peer = dp_peer_find_hash_find(soc, src_mac_addr, 0,
+				      DP_VDEV_ALL, DP_MOD_ID_MSCS);
+	if (peer) {
+		entry->soc = soc;
+		qdf_mem_copy(entry->mac_addr, src_mac_addr, QDF_MAC_ADDR_SIZE);
+		entry->peer_id = peer->peer_id;
+	}
+
+	return peer;
+}
+
 /**
  * dp_mscs_peer_lookup_n_get_priority() - Get priority for MSCS peer
  * @soc_hdl - soc handle
@@ -53,8 +115,7 @@ int dp_mscs_peer_lookup_n_get_priority(struct cdp_soc_t *soc_hdl,
 	/*
 	 * Find the MSCS peer from global soc
 	 */
-	src_peer = dp_peer_find_hash_find(dpsoc, src_mac_addr, 0,
-			DP_VDEV_ALL, DP_MOD_ID_MSCS);
+	src_peer = dp_mscs_src_peer_get(dpsoc, src_mac_addr);
 
 	if (!src_peer) {
 		dst_peer = dp_peer_find_hash_find(dpsoc, dst_mac_addr, 0,
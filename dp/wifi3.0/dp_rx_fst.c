@@ -25,6 +25,7 @@
 #include "dp_types.h"
 #include "hal_rx_flow.h"
 #include "dp_htt.h"
+#include "dp_rx_tag.h"
 
 /**
  * In Hawkeye, a hardware bug disallows SW to only clear a single flow entry
@@ -37,6 +38,129 @@
 #define HW_RX_FSE_CACHE_INVALIDATE_BUNDLE_PERIOD_MS (100)
 #define HW_RX_FSE_CACHE_INVALIDATE_DELAYED_FST_SETUP_MS (5000)
 
+/* Shadow index chain terminator and reader retry limit */
+#define DP_RX_FST_SHADOW_INVALID_IDX 0xFFFFFFFF
+#define DP_RX_FST_SHADOW_MAX_RETRY 8
+
+/**
+ * struct dp_rx_fst_shadow_node - Shadow index node, one per FSE index
+ * @tuple: Native 5-tuple of the flow, IPv4 prefix normalized
+ * @next: Next FSE index in the bucket chain
+ * @in_use: Node is linked in a bucket
+ */
+struct dp_rx_fst_shadow_node {
+	struct cdp_rx_flow_tuple_info tuple;
+	uint32_t next;
+	bool in_use;
+};
+
+/**
+ * struct dp_rx_fst_shadow - Host side 5-tuple to FSE index map
+ * @lock: Serializes writers
+ * @seq: Sequence count, odd while a writer is modifying the index
+ * @bucket_mask: Number of buckets - 1
+ * @bucket: Head FSE index of every bucket chain
+ * @node: Nodes indexed by FSE index
+ *
+ * Readers do not take @lock, they retry if @seq changed during the walk.
+ * Nodes are never freed while the FST exists so a walk racing with a
+ * writer only needs to be repeated, not protected.
+ */
+struct dp_rx_fst_shadow {
+	qdf_spinlock_t lock;
+	qdf_atomic_t seq;
+	uint32_t bucket_mask;
+	uint32_t *bucket;
+	struct dp_rx_fst_shadow_node *node;
+};
+
+/*
+ * Idle flow aging runs as a timer wheel: every tick scans one slot, i.e.
+ * the FSE indices congruent to the slot number, so a full revolution visits
+ * each entry once. A flow whose msdu count did not move for
+ * DP_RX_FST_AGING_IDLE_ROUNDS revolutions is reclaimed.
+ */
+#define DP_RX_FST_AGING_WHEEL_SLOTS 16
+#define DP_RX_FST_AGING_IDLE_ROUNDS 2
+#define DP_RX_FST_AGING_MIN_TICK_MS 10
+#define DP_RX_FST_AGING_MAX_BATCH 64
+
+/**
+ * struct dp_rx_fst_age_entry - Aging state of one FSE
+ * @last_msdu_count: msdu count seen on the previous visit
+ * @idle_rounds: Consecutive visits without msdu count change
+ */
+struct dp_rx_fst_age_entry {
+	uint32_t last_msdu_count;
+	uint16_t idle_rounds;
+};
+
+/**
+ * struct dp_rx_fst_aging - Idle flow aging engine
+ * @timer: Wheel tick timer
+ * @pdev: Pdev used to send cache invalidate commands
+ * @entry: Aging state indexed by FSE index
+ * @tick_ms: Wheel tick period
+ * @cur_slot: Slot scanned on the next tick
+ * @cur_idx: FSE index in @cur_slot to resume the scan from
+ * @enabled: Aging is configured
+ * @notify_cb: Callback for reclaimed flows
+ * @notify_ctx: Context passed to @notify_cb
+ * @flows: Flows reclaimed in one tick, only used by the timer handler
+ * @num_reclaimed: Flows reclaimed since aging was enabled
+ * @num_ticks: Wheel ticks processed
+ */
+struct dp_rx_fst_aging {
+	qdf_timer_t timer;
+	struct dp_pdev *pdev;
+	struct dp_rx_fst_age_entry *entry;
+	uint32_t tick_ms;
+	uint32_t cur_slot;
+	uint32_t cur_idx;
+	bool enabled;
+	dp_rx_flow_aging_notify_cb notify_cb;
+	void *notify_ctx;
+	struct cdp_rx_flow_info *flows;
+	uint64_t num_reclaimed;
+	uint64_t num_ticks;
+};
+
+/**
+ * struct dp_rx_fst_ctx - DP FST with host side bookkeeping
+ * @fst: DP FST, handed out as pdev/soc rx_fst
+ * @lock: Serializes FST updates from control path and aging
+ * @shadow: Shadow index for 5-tuple lookups
+ * @aging: Idle flow aging engine
+ */
+struct dp_rx_fst_ctx {
+	struct dp_rx_fst fst;
+	qdf_spinlock_t lock;
+	struct dp_rx_fst_shadow shadow;
+	struct dp_rx_fst_aging aging;
+};
+
+static inline struct dp_rx_fst_ctx *dp_rx_fst_get_ctx(struct dp_rx_fst *fst)
+{
+	return qdf_container_of(fst, struct dp_rx_fst_ctx, fst);
+}
+
+/**
+ * dp_rx_fst_aging_reset_entry() - Restart aging of a newly added flow
+ * @fst: Rx FST Handle
+ * @fse: DP FSE of the flow
+ *
+ * Return: None
+ */
+static inline void dp_rx_fst_aging_reset_entry(struct dp_rx_fst *fst,
+					       struct dp_rx_fse *fse)
+{
+	struct dp_rx_fst_age_entry *age;
+
+	age = &dp_rx_fst_get_ctx(fst)->aging.entry[fse->flow_id];
+	age->last_msdu_count = fse->stats.msdu_count;
+	age->idle_rounds = 0;
+}
+
 /**
  * dp_rx_flow_get_fse() - Obtain flow search entry from flow hash
  * @fst: Rx FST Handle
@@ -83,16 +207,15 @@ void dp_rx_flow_dump_flow_entry(struct dp_rx_fst *fst,
 }
 
 /**
- * dp_rx_flow_compute_flow_hash() - Print flow search entry from 5-tuple
- * @fst: Rx FST Handle
+ * dp_rx_flow_compute_tuple() - Fill HAL flow 5-tuple from DP flow parameters
  * @rx_flow_info: DP Rx Flow 5-tuple programmed by upper layer
  * @flow: HAL (HW) flow entry
  *
- * Return: Computed Toeplitz hash
+ * Return: None
  */
-uint32_t dp_rx_flow_compute_flow_hash(struct dp_rx_fst *fst,
-				      struct cdp_rx_flow_info *rx_flow_info,
-				      struct hal_rx_flow *flow)
+static inline void
+dp_rx_flow_compute_tuple(struct cdp_rx_flow_info *rx_flow_info,
+			 struct hal_rx_flow *flow)
 {
 	flow->tuple_info.dest_ip_127_96 =
 			rx_flow_info->flow_tuple_info.dest_ip_127_96;
@@ -116,10 +239,66 @@ uint32_t dp_rx_flow_compute_flow_hash(struct dp_rx_fst *fst,
 			rx_flow_info->flow_tuple_info.src_port;
 	flow->tuple_info.l4_protocol =
 			rx_flow_info->flow_tuple_info.l4_protocol;
+}
+
+/**
+ * dp_rx_flow_compute_flow_hash() - Print flow search entry from 5-tuple
+ * @fst: Rx FST Handle
+ * @rx_flow_info: DP Rx Flow 5-tuple programmed by upper layer
+ * @flow: HAL (HW) flow entry
+ *
+ * Return: Computed Toeplitz hash
+ */
+uint32_t dp_rx_flow_compute_flow_hash(struct dp_rx_fst *fst,
+				      struct cdp_rx_flow_info *rx_flow_info,
+				      struct hal_rx_flow *flow)
+{
+	dp_rx_flow_compute_tuple(rx_flow_info, flow);
 
 	return hal_flow_toeplitz_hash(fst->hal_rx_fst, flow);
 }
 
+/**
+ * dp_rx_flow_alloc_entry_by_hash() - Create DP and HAL flow entries in FST
+ *				      for a precomputed flow hash
+ * @hal_soc: HAL SOC handle
+ * @fst: Rx FST Handle
+ * @rx_flow_info: DP Rx Flow 5-tuple to be added to DP FST
+ * @flow_hash: Toeplitz hash of the 5-tuple
+ *
+ * Return: Handle to the allocated DP FSE, NULL on failure
+ */
+static struct dp_rx_fse *
+dp_rx_flow_alloc_entry_by_hash(hal_soc_handle_t hal_soc,
+			       struct dp_rx_fst *fst,
+			       struct cdp_rx_flow_info *rx_flow_info,
+			       uint32_t flow_hash)
+{
+	struct dp_rx_fse *fse = NULL;
+	uint32_t flow_idx;
+	QDF_STATUS status;
+
+	status = hal_rx_insert_flow_entry(hal_soc,
+					  fst->hal_rx_fst,
+					  flow_hash,
+					  &rx_flow_info->flow_tuple_info,
+					  &flow_idx);
+	if (status != QDF_STATUS_SUCCESS) {
+		dp_err("Add entry failed with status %d for tuple with hash %u",
+		       status, flow_hash);
+		return NULL;
+	}
+
+	fse = dp_rx_flow_get_fse(fst, flow_idx);
+	fse->is_ipv4_addr_entry = rx_flow_info->is_addr_ipv4;
+	fse->flow_hash = flow_hash;
+	fse->flow_id = flow_idx;
+	fse->stats.msdu_count = 0;
+	fse->is_valid = true;
+
+	return fse;
+}
+
 /**
  * dp_rx_flow_alloc_entry() - Create DP and HAL flow entries in FST
  * @hal_soc_hdl: HAL SOC handle
@@ -134,284 +313,1113 @@ struct dp_rx_fse *dp_rx_flow_alloc_entry(hal_soc_handle_t hal_soc,
 					 struct cdp_rx_flow_info *rx_flow_info,
 					 struct hal_rx_flow *flow)
 {
-	struct dp_rx_fse *fse = NULL;
-	uint32_t flow_hash;
-	uint32_t flow_idx;
+	uint32_t flow_hash;
+
+	flow_hash = dp_rx_flow_compute_flow_hash(fst, rx_flow_info, flow);
+
+	return dp_rx_flow_alloc_entry_by_hash(hal_soc, fst, rx_flow_info,
+					      flow_hash);
+}
+
+/**
+ * dp_rx_flow_find_entry_by_hash() - Find the DP FSE matching a given 5-tuple
+ *				     for a precomputed flow hash
+ * @hal_soc_hdl: HAL SOC handle
+ * @fst: Rx FST Handle
+ * @rx_flow_info: DP Rx Flow 5-tuple
+ * @flow_hash: Toeplitz hash of the 5-tuple
+ *
+ * Return: Pointer to the DP FSE entry, NULL if not found
+ */
+static struct dp_rx_fse *
+dp_rx_flow_find_entry_by_hash(hal_soc_handle_t hal_soc_hdl,
+			      struct dp_rx_fst *fst,
+			      struct cdp_rx_flow_info *rx_flow_info,
+			      uint32_t flow_hash)
+{
+	uint32_t flow_idx;
+	QDF_STATUS status;
+
+	status = hal_rx_find_flow_from_tuple(hal_soc_hdl,
+					     fst->hal_rx_fst,
+					     flow_hash,
+					     &rx_flow_info->flow_tuple_info,
+					     &flow_idx);
+	if (status != QDF_STATUS_SUCCESS)
+		return NULL;
+
+	return dp_rx_flow_get_fse(fst, flow_idx);
+}
+
+/**
+ * dp_rx_flow_find_entry_by_tuple() - Find the DP FSE matching a given 5-tuple
+ * @fst: Rx FST Handle
+ * @rx_flow_info: DP Rx Flow 5-tuple
+ * @flow: Pointer to the  HAL (HW) flow entry
+ *
+ * Return: Pointer to the DP FSE entry
+ */
+struct dp_rx_fse *
+dp_rx_flow_find_entry_by_tuple(hal_soc_handle_t hal_soc_hdl,
+			       struct dp_rx_fst *fst,
+			       struct cdp_rx_flow_info *rx_flow_info,
+			       struct hal_rx_flow *flow)
+{
+	struct dp_rx_fse *fse;
+	uint32_t flow_hash;
+
+	flow_hash = dp_rx_flow_compute_flow_hash(fst, rx_flow_info, flow);
+
+	fse = dp_rx_flow_find_entry_by_hash(hal_soc_hdl, fst, rx_flow_info,
+					    flow_hash);
+	if (!fse) {
+		dp_err("Could not find tuple with hash %u", flow_hash);
+		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
+		return NULL;
+	}
+	return fse;
+}
+
+/**
+ * dp_rx_fst_shadow_key() - Build normalized shadow index key for a flow
+ * @rx_flow_info: DP flow parameters
+ * @key: Key filled on return
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_fst_shadow_key(struct cdp_rx_flow_info *rx_flow_info,
+		     struct cdp_rx_flow_tuple_info *key)
+{
+	qdf_mem_zero(key, sizeof(*key));
+	key->dest_ip_31_0 = rx_flow_info->flow_tuple_info.dest_ip_31_0;
+	key->src_ip_31_0 = rx_flow_info->flow_tuple_info.src_ip_31_0;
+	key->dest_port = rx_flow_info->flow_tuple_info.dest_port;
+	key->src_port = rx_flow_info->flow_tuple_info.src_port;
+	key->l4_protocol = rx_flow_info->flow_tuple_info.l4_protocol;
+
+	if (rx_flow_info->is_addr_ipv4) {
+		key->dest_ip_127_96 = HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+		key->src_ip_127_96 = HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+		return;
+	}
+
+	key->dest_ip_127_96 = rx_flow_info->flow_tuple_info.dest_ip_127_96;
+	key->dest_ip_95_64 = rx_flow_info->flow_tuple_info.dest_ip_95_64;
+	key->dest_ip_63_32 = rx_flow_info->flow_tuple_info.dest_ip_63_32;
+	key->src_ip_127_96 = rx_flow_info->flow_tuple_info.src_ip_127_96;
+	key->src_ip_95_64 = rx_flow_info->flow_tuple_info.src_ip_95_64;
+	key->src_ip_63_32 = rx_flow_info->flow_tuple_info.src_ip_63_32;
+}
+
+/**
+ * dp_rx_fst_shadow_tuple_match() - Compare two normalized shadow keys
+ * @a: First key
+ * @b: Second key
+ *
+ * Return: true if the 5-tuples are equal
+ */
+static inline bool
+dp_rx_fst_shadow_tuple_match(struct cdp_rx_flow_tuple_info *a,
+			     struct cdp_rx_flow_tuple_info *b)
+{
+	return a->dest_ip_31_0 == b->dest_ip_31_0 &&
+	       a->src_ip_31_0 == b->src_ip_31_0 &&
+	       a->dest_port == b->dest_port &&
+	       a->src_port == b->src_port &&
+	       a->l4_protocol == b->l4_protocol &&
+	       a->dest_ip_63_32 == b->dest_ip_63_32 &&
+	       a->src_ip_63_32 == b->src_ip_63_32 &&
+	       a->dest_ip_95_64 == b->dest_ip_95_64 &&
+	       a->src_ip_95_64 == b->src_ip_95_64 &&
+	       a->dest_ip_127_96 == b->dest_ip_127_96 &&
+	       a->src_ip_127_96 == b->src_ip_127_96;
+}
+
+/**
+ * dp_rx_fst_shadow_hash() - Bucket of a normalized shadow key
+ * @shadow: Shadow index
+ * @key: Normalized 5-tuple
+ *
+ * Return: Bucket index
+ */
+static inline uint32_t
+dp_rx_fst_shadow_hash(struct dp_rx_fst_shadow *shadow,
+		      struct cdp_rx_flow_tuple_info *key)
+{
+	uint32_t hash;
+
+	hash = key->dest_ip_31_0 ^ key->dest_ip_63_32 ^
+	       key->dest_ip_95_64 ^ key->dest_ip_127_96;
+	hash = (hash * 0x9E3779B1) ^ key->src_ip_31_0 ^ key->src_ip_63_32 ^
+	       key->src_ip_95_64 ^ key->src_ip_127_96;
+	hash = (hash * 0x9E3779B1) ^
+	       (((uint32_t)key->dest_port << 16) | key->src_port);
+	hash = (hash * 0x9E3779B1) ^ key->l4_protocol;
+	hash ^= hash >> 16;
+
+	return hash & shadow->bucket_mask;
+}
+
+/**
+ * dp_rx_fst_shadow_attach() - Allocate shadow index for the FST
+ * @shadow: Shadow index
+ * @max_entries: Number of FSE entries, power of 2
+ *
+ * Return: Success when allocated, no-memory on error
+ */
+static QDF_STATUS
+dp_rx_fst_shadow_attach(struct dp_rx_fst_shadow *shadow, uint32_t max_entries)
+{
+	uint32_t i;
+
+	shadow->bucket = qdf_mem_malloc(max_entries * sizeof(uint32_t));
+	if (!shadow->bucket)
+		return QDF_STATUS_E_NOMEM;
+
+	shadow->node = qdf_mem_malloc(max_entries *
+				      sizeof(struct dp_rx_fst_shadow_node));
+	if (!shadow->node) {
+		qdf_mem_free(shadow->bucket);
+		shadow->bucket = NULL;
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	for (i = 0; i < max_entries; i++)
+		shadow->bucket[i] = DP_RX_FST_SHADOW_INVALID_IDX;
+
+	shadow->bucket_mask = max_entries - 1;
+	qdf_atomic_init(&shadow->seq);
+	qdf_spinlock_create(&shadow->lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_rx_fst_shadow_detach() - Free shadow index of the FST
+ * @shadow: Shadow index
+ *
+ * Return: None
+ */
+static void dp_rx_fst_shadow_detach(struct dp_rx_fst_shadow *shadow)
+{
+	qdf_spinlock_destroy(&shadow->lock);
+	qdf_mem_free(shadow->node);
+	qdf_mem_free(shadow->bucket);
+	shadow->node = NULL;
+	shadow->bucket = NULL;
+}
+
+/**
+ * dp_rx_fst_shadow_insert() - Map a flow to its FSE index
+ * @fst: Rx FST Handle
+ * @rx_flow_info: DP flow parameters
+ * @flow_idx: FSE index of the flow
+ *
+ * Return: None
+ */
+static void dp_rx_fst_shadow_insert(struct dp_rx_fst *fst,
+				    struct cdp_rx_flow_info *rx_flow_info,
+				    uint32_t flow_idx)
+{
+	struct dp_rx_fst_shadow *shadow = &dp_rx_fst_get_ctx(fst)->shadow;
+	struct dp_rx_fst_shadow_node *node = &shadow->node[flow_idx];
+	uint32_t bkt;
+
+	qdf_spin_lock_bh(&shadow->lock);
+	qdf_atomic_inc(&shadow->seq);
+	qdf_mb();
+
+	dp_rx_fst_shadow_key(rx_flow_info, &node->tuple);
+	bkt = dp_rx_fst_shadow_hash(shadow, &node->tuple);
+	node->next = shadow->bucket[bkt];
+	node->in_use = true;
+	shadow->bucket[bkt] = flow_idx;
+
+	qdf_mb();
+	qdf_atomic_inc(&shadow->seq);
+	qdf_spin_unlock_bh(&shadow->lock);
+}
+
+/**
+ * dp_rx_fst_shadow_remove() - Unmap a flow from its FSE index
+ * @fst: Rx FST Handle
+ * @flow_idx: FSE index of the flow
+ *
+ * Return: None
+ */
+static void dp_rx_fst_shadow_remove(struct dp_rx_fst *fst, uint32_t flow_idx)
+{
+	struct dp_rx_fst_shadow *shadow = &dp_rx_fst_get_ctx(fst)->shadow;
+	struct dp_rx_fst_shadow_node *node = &shadow->node[flow_idx];
+	uint32_t *link;
+	uint32_t bkt;
+
+	qdf_spin_lock_bh(&shadow->lock);
+	if (!node->in_use) {
+		qdf_spin_unlock_bh(&shadow->lock);
+		return;
+	}
+
+	qdf_atomic_inc(&shadow->seq);
+	qdf_mb();
+
+	bkt = dp_rx_fst_shadow_hash(shadow, &node->tuple);
+	link = &shadow->bucket[bkt];
+	while (*link != DP_RX_FST_SHADOW_INVALID_IDX) {
+		if (*link == flow_idx) {
+			*link = node->next;
+			break;
+		}
+		link = &shadow->node[*link].next;
+	}
+	node->in_use = false;
+	node->next = DP_RX_FST_SHADOW_INVALID_IDX;
+
+	qdf_mb();
+	qdf_atomic_inc(&shadow->seq);
+	qdf_spin_unlock_bh(&shadow->lock);
+}
+
+/**
+ * dp_rx_fst_shadow_lookup() - Find the FSE index of a flow in shadow index
+ * @fst: Rx FST Handle
+ * @rx_flow_info: DP flow parameters
+ * @flow_idx: FSE index of the flow on success
+ *
+ * Return: Success when found, no-entry when absent, failure if the lookup
+ *	   kept racing with writers and the caller should use the HAL table
+ */
+static QDF_STATUS dp_rx_fst_shadow_lookup(struct dp_rx_fst *fst,
+					  struct cdp_rx_flow_info *rx_flow_info,
+					  uint32_t *flow_idx)
+{
+	struct dp_rx_fst_shadow *shadow = &dp_rx_fst_get_ctx(fst)->shadow;
+	struct cdp_rx_flow_tuple_info key;
+	uint32_t bkt, idx, hops;
+	int seq, retry;
+
+	dp_rx_fst_shadow_key(rx_flow_info, &key);
+	bkt = dp_rx_fst_shadow_hash(shadow, &key);
+
+	for (retry = 0; retry < DP_RX_FST_SHADOW_MAX_RETRY; retry++) {
+		seq = qdf_atomic_read(&shadow->seq);
+		if (seq & 1)
+			continue;
+		qdf_mb();
+
+		idx = shadow->bucket[bkt];
+		for (hops = 0; idx != DP_RX_FST_SHADOW_INVALID_IDX &&
+		     hops <= shadow->bucket_mask; hops++) {
+			if (dp_rx_fst_shadow_tuple_match(&shadow->node[idx].tuple,
+							 &key))
+				break;
+			idx = shadow->node[idx].next;
+		}
+
+		qdf_mb();
+		if (seq != qdf_atomic_read(&shadow->seq))
+			continue;
+
+		if (idx == DP_RX_FST_SHADOW_INVALID_IDX)
+			return QDF_STATUS_E_NOENT;
+
+		*flow_idx = idx;
+		return QDF_STATUS_SUCCESS;
+	}
+
+	return QDF_STATUS_E_FAILURE;
+}
+
+/**
+ * dp_rx_flow_find_entry_by_shadow() - Find the DP FSE matching a 5-tuple
+ *				       using the shadow index
+ * @hal_soc_hdl: HAL SOC handle
+ * @fst: Rx FST Handle
+ * @rx_flow_info: DP Rx Flow 5-tuple
+ *
+ * Falls back to the hash based HAL lookup only if the shadow lookup could
+ * not complete due to concurrent updates.
+ *
+ * Return: Pointer to the DP FSE entry, NULL if not found
+ */
+static struct dp_rx_fse *
+dp_rx_flow_find_entry_by_shadow(hal_soc_handle_t hal_soc_hdl,
+				struct dp_rx_fst *fst,
+				struct cdp_rx_flow_info *rx_flow_info)
+{
+	struct hal_rx_flow flow = { 0 };
+	struct dp_rx_fse *fse;
+	uint32_t flow_idx;
+	QDF_STATUS status;
+
+	status = dp_rx_fst_shadow_lookup(fst, rx_flow_info, &flow_idx);
+	if (status == QDF_STATUS_E_NOENT)
+		return NULL;
+
+	if (status != QDF_STATUS_SUCCESS)
+		return dp_rx_flow_find_entry_by_tuple(hal_soc_hdl, fst,
+						      rx_flow_info, &flow);
+
+	fse = dp_rx_flow_get_fse(fst, flow_idx);
+	if (qdf_unlikely(!fse->is_valid))
+		return NULL;
+
+	return fse;
+}
+
+/**
+ * dp_rx_flow_find_entry_by_flowid() - Find DP FSE matching a given flow index
+ * @fst: Rx FST Handle
+ * @flow_id: Flow index of the requested flow
+ *
+ * Return: Pointer to the DP FSE entry
+ */
+struct dp_rx_fse *
+dp_rx_flow_find_entry_by_flowid(struct dp_rx_fst *fst,
+				uint32_t flow_id)
+{
+	struct dp_rx_fse *fse = NULL;
+
+	fse = dp_rx_flow_get_fse(fst, flow_id);
+	if (!fse->is_valid)
+		return NULL;
+
+	dp_info("flow_idx= %d, flow_addr = %pK", flow_id, fse);
+	qdf_assert_always(fse->flow_id == flow_id);
+
+	return fse;
+}
+
+/**
+ * dp_rx_flow_send_htt_operation_cmd() - Send HTT FSE command to FW for flow
+ *					 addition/removal
+ * @pdev: Pdev instance
+ * @op: Add/delete operation
+ * @info: DP Flow parameters of the flow added/deleted
+ *
+ * Return: Success on sending HTT command to FW, error on failure
+ */
+QDF_STATUS dp_rx_flow_send_htt_operation_cmd(struct dp_pdev *pdev,
+					     enum dp_htt_flow_fst_operation op,
+					     struct cdp_rx_flow_info *info)
+{
+	struct dp_htt_rx_flow_fst_operation fst_op;
+	struct wlan_cfg_dp_soc_ctxt *cfg = pdev->soc->wlan_cfg_ctx;
+
+	qdf_mem_set(&fst_op, 0, sizeof(struct dp_htt_rx_flow_fst_operation));
+
+	if (qdf_unlikely(wlan_cfg_is_rx_flow_search_table_per_pdev(cfg))) {
+		/* Firmware pdev ID starts from 1 */
+		fst_op.pdev_id = DP_SW2HW_MACID(pdev->pdev_id);
+	} else {
+		fst_op.pdev_id = 0;
+	}
+
+	fst_op.op_code = op;
+	fst_op.rx_flow = info;
+
+	return dp_htt_rx_flow_fse_operation(pdev, &fst_op);
+}
+
+/**
+ * dp_rx_flow_init_tuple() - Initialize unused bits of the flow 5-tuple
+ * @rx_flow_info: DP flow paramaters
+ *
+ * Return: None
+ */
+static inline void
+dp_rx_flow_init_tuple(struct cdp_rx_flow_info *rx_flow_info)
+{
+	/* Initialize unused bits in IPv6 address for IPv4 address */
+	if (rx_flow_info->is_addr_ipv4) {
+		rx_flow_info->flow_tuple_info.dest_ip_63_32 = 0;
+		rx_flow_info->flow_tuple_info.dest_ip_95_64 = 0;
+		rx_flow_info->flow_tuple_info.dest_ip_127_96 =
+			HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+
+		rx_flow_info->flow_tuple_info.src_ip_63_32 = 0;
+		rx_flow_info->flow_tuple_info.src_ip_95_64 = 0;
+		rx_flow_info->flow_tuple_info.src_ip_127_96 =
+			HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+	}
+}
+
+/**
+ * dp_rx_flow_setup_hw_entry() - Populate the HW FSE for an allocated DP FSE
+ * @pdev: DP pdev instance
+ * @fse: DP FSE allocated for the flow
+ * @rx_flow_info: DP flow paramaters
+ * @flow: HAL (HW) flow entry with the 5-tuple filled in
+ *
+ * Return: Success when HW FSE is populated, already exists on error
+ */
+static QDF_STATUS
+dp_rx_flow_setup_hw_entry(struct dp_pdev *pdev, struct dp_rx_fse *fse,
+			  struct cdp_rx_flow_info *rx_flow_info,
+			  struct hal_rx_flow *flow)
+{
+	struct dp_soc *soc = pdev->soc;
+	struct dp_rx_fst *fst = pdev->rx_fst;
+
+	/* Initialize other parameters for HW flow & populate HW FSE entry */
+	flow->reo_destination_indication = (fse->flow_hash &
+				HAL_REO_DEST_IND_HASH_MASK);
+
+	/**
+	 * Reo destination of each flow is mapped to match the same used
+	 * by RX Hash algorithm. If RX Hash is disabled, then the REO
+	 * destination below is directly got from pdev, rather than using
+	 * dp_peer_setup_get_reo_hash since we do not have vdev handle here.
+	 */
+	if (wlan_cfg_is_rx_hash_enabled(soc->wlan_cfg_ctx)) {
+		flow->reo_destination_indication |=
+			HAL_REO_DEST_IND_START_OFFSET;
+	} else {
+		flow->reo_destination_indication = pdev->reo_dest;
+	}
+
+	flow->reo_destination_handler = HAL_RX_FSE_REO_DEST_FT;
+	flow->fse_metadata = rx_flow_info->fse_metadata;
+	fse->hal_rx_fse = hal_rx_flow_setup_fse(soc->hal_soc, fst->hal_rx_fst,
+						fse->flow_id, flow);
+	if (qdf_unlikely(!fse->hal_rx_fse)) {
+		dp_err("Unable to alloc FSE entry");
+		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
+		/* Free up the FSE entry as returning failure */
+		fse->is_valid = false;
+		return QDF_STATUS_E_EXISTS;
+	}
+
+	/* Increment number of valid entries in table */
+	fst->num_entries++;
+	dp_rx_fst_shadow_insert(fst, rx_flow_info, fse->flow_id);
+	dp_rx_fst_aging_reset_entry(fst, fse);
+	dp_info("FST num_entries = %d, reo_dest_ind = %d, reo_dest_hand = %u",
+		fst->num_entries, flow->reo_destination_indication,
+		flow->reo_destination_handler);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_rx_flow_batch_invalidate() - Invalidate FSE cache once for a batch
+ * @pdev: pdev handle
+ * @rx_flow_info: Array of DP flow parameters
+ * @num_flows: Number of entries in @rx_flow_info
+ * @status: Per-entry status, only successful entries are invalidated,
+ *	    NULL if all entries were updated
+ * @num_updated: Number of successful entries in @status
+ *
+ * A single updated entry is invalidated by tuple, more than one is
+ * coalesced into one full cache invalidate.
+ *
+ * Return: Success when the invalidate is sent or deferred, error otherwise
+ */
+static QDF_STATUS
+dp_rx_flow_batch_invalidate(struct dp_pdev *pdev,
+			    struct cdp_rx_flow_info *rx_flow_info,
+			    uint32_t num_flows, QDF_STATUS *status,
+			    uint32_t num_updated)
+{
+	struct dp_soc *soc = pdev->soc;
+	struct dp_rx_fst *fst = pdev->rx_fst;
+	uint32_t i;
+
+	if (!num_updated)
+		return QDF_STATUS_SUCCESS;
+
+	if (soc->is_rx_fse_full_cache_invalidate_war_enabled) {
+		qdf_atomic_set(&fst->is_cache_update_pending, 1);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	if (num_updated > 1)
+		return dp_rx_flow_send_htt_operation_cmd(
+					pdev,
+					DP_HTT_FST_CACHE_INVALIDATE_FULL,
+					NULL);
+
+	for (i = 0; status && i < num_flows; i++) {
+		if (status[i] == QDF_STATUS_SUCCESS)
+			break;
+	}
+
+	return dp_rx_flow_send_htt_operation_cmd(
+					pdev,
+					DP_HTT_FST_CACHE_INVALIDATE_ENTRY,
+					&rx_flow_info[i]);
+}
+
+/**
+ * dp_rx_flow_remove_entry() - Remove a flow from the DP, HAL and shadow FST
+ * @pdev: DP pdev instance
+ * @rx_flow_info: DP flow parameters
+ *
+ * Used to roll back an add whose cache invalidate could not be sent. Must
+ * be called with the FST lock held.
+ *
+ * Return: None
+ */
+static void dp_rx_flow_remove_entry(struct dp_pdev *pdev,
+				    struct cdp_rx_flow_info *rx_flow_info)
+{
+	struct dp_soc *soc = pdev->soc;
+	struct dp_rx_fst *fst = pdev->rx_fst;
+	struct dp_rx_fse *fse;
+
+	fse = dp_rx_flow_find_entry_by_shadow(soc->hal_soc, fst, rx_flow_info);
+	if (!fse)
+		return;
+
+	hal_rx_flow_delete_entry(soc->hal_soc, fst->hal_rx_fst, fse->hal_rx_fse);
+	dp_rx_fst_shadow_remove(fst, fse->flow_id);
+	fse->is_valid = false;
+	fst->num_entries--;
+}
+
+/* Add a flow to the DP/HAL FST, called with the FST lock held */
+static QDF_STATUS
+__dp_rx_flow_add_entry(struct dp_pdev *pdev,
+		       struct cdp_rx_flow_info *rx_flow_info)
+{
+	struct hal_rx_flow flow = { 0 };
+	struct dp_rx_fse *fse;
+	struct dp_soc *soc = pdev->soc;
+	struct dp_rx_fst *fst;
+
+	fst = pdev->rx_fst;
+
+	dp_rx_flow_init_tuple(rx_flow_info);
+
+	/* Allocate entry in DP FST */
+	fse = dp_rx_flow_alloc_entry(soc->hal_soc, fst, rx_flow_info, &flow);
+	if (NULL == fse) {
+		dp_err("RX FSE alloc failed");
+		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
+		return QDF_STATUS_E_NOMEM;
+	}
+	dp_info("flow_addr = %pK, flow_id = %u, valid = %d, v4 = %d\n",
+		fse, fse->flow_id, fse->is_valid, fse->is_ipv4_addr_entry);
+
+	return dp_rx_flow_setup_hw_entry(pdev, fse, rx_flow_info, &flow);
+}
+
+/* Delete a flow from the DP/HAL FST, called with the FST lock held */
+static QDF_STATUS
+__dp_rx_flow_delete_entry(struct dp_pdev *pdev,
+			  struct cdp_rx_flow_info *rx_flow_info)
+{
+	struct dp_rx_fse *fse;
+	struct dp_soc *soc = pdev->soc;
+	struct dp_rx_fst *fst;
+	QDF_STATUS status;
+
+	fst = pdev->rx_fst;
+
+	/* Find the given flow entry DP FST */
+	fse = dp_rx_flow_find_entry_by_shadow(soc->hal_soc, fst, rx_flow_info);
+
+	if (!fse) {
+		dp_err("RX flow delete entry failed");
+		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	/* Delete the FSE in HW FST */
+	status = hal_rx_flow_delete_entry(soc->hal_soc, fst->hal_rx_fst,
+					  fse->hal_rx_fse);
+	qdf_assert_always(status == QDF_STATUS_SUCCESS);
+
+	/* Free the FSE in DP FST */
+	dp_rx_fst_shadow_remove(fst, fse->flow_id);
+	fse->is_valid = false;
+
+	/* Decrement number of valid entries in table */
+	fst->num_entries--;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/* Add flows to the DP/HAL FST, called with the FST lock held */
+static void
+__dp_rx_flow_add_entry_batch(struct dp_pdev *pdev,
+			     struct cdp_rx_flow_info *rx_flow_info,
+			     uint32_t *flow_hash, uint32_t num_flows,
+			     QDF_STATUS *status, uint32_t *num_added)
+{
+	struct hal_rx_flow flow = { 0 };
+	struct dp_soc *soc = pdev->soc;
+	struct dp_rx_fst *fst = pdev->rx_fst;
+	struct dp_rx_fse *fse;
+	uint32_t i;
+
+	*num_added = 0;
+	for (i = 0; i < num_flows; i++) {
+		fse = dp_rx_flow_alloc_entry_by_hash(soc->hal_soc, fst,
+						     &rx_flow_info[i],
+						     flow_hash[i]);
+		if (!fse) {
+			dp_rx_flow_dump_flow_entry(fst, &rx_flow_info[i]);
+			status[i] = QDF_STATUS_E_NOMEM;
+			continue;
+		}
+
+		qdf_mem_zero(&flow, sizeof(flow));
+		dp_rx_flow_compute_tuple(&rx_flow_info[i], &flow);
+		status[i] = dp_rx_flow_setup_hw_entry(pdev, fse,
+						      &rx_flow_info[i], &flow);
+		if (status[i] == QDF_STATUS_SUCCESS)
+			(*num_added)++;
+	}
+}
+
+/* Delete flows from the DP/HAL FST, called with the FST lock held */
+static void
+__dp_rx_flow_delete_entry_batch(struct dp_pdev *pdev,
+				struct cdp_rx_flow_info *rx_flow_info,
+				uint32_t num_flows, QDF_STATUS *status,
+				uint32_t *num_deleted)
+{
+	struct dp_soc *soc = pdev->soc;
+	struct dp_rx_fst *fst = pdev->rx_fst;
+	struct dp_rx_fse *fse;
+	uint32_t i;
+
+	*num_deleted = 0;
+	for (i = 0; i < num_flows; i++) {
+		fse = dp_rx_flow_find_entry_by_shadow(soc->hal_soc, fst,
+						      &rx_flow_info[i]);
+		if (!fse) {
+			dp_rx_flow_dump_flow_entry(fst, &rx_flow_info[i]);
+			status[i] = QDF_STATUS_E_INVAL;
+			continue;
+		}
+
+		status[i] = hal_rx_flow_delete_entry(soc->hal_soc,
+						     fst->hal_rx_fst,
+						     fse->hal_rx_fse);
+		qdf_assert_always(status[i] == QDF_STATUS_SUCCESS);
+
+		dp_rx_fst_shadow_remove(fst, fse->flow_id);
+		fse->is_valid = false;
+		fst->num_entries--;
+		(*num_deleted)++;
+	}
+}
+
+/**
+ * dp_rx_flow_add_entry() - Add a flow entry to flow search table
+ * @pdev: DP pdev instance
+ * @rx_flow_info: DP flow paramaters
+ *
+ * Return: Success when flow is added, no-memory or already exists on error
+ */
+QDF_STATUS dp_rx_flow_add_entry(struct dp_pdev *pdev,
+				struct cdp_rx_flow_info *rx_flow_info)
+{
+	struct dp_rx_fst_ctx *fst_ctx = dp_rx_fst_get_ctx(pdev->rx_fst);
 	QDF_STATUS status;
 
-	flow_hash = dp_rx_flow_compute_flow_hash(fst, rx_flow_info, flow);
+	qdf_spin_lock_bh(&fst_ctx->lock);
+	status = __dp_rx_flow_add_entry(pdev, rx_flow_info);
+	qdf_spin_unlock_bh(&fst_ctx->lock);
 
-	status = hal_rx_insert_flow_entry(hal_soc,
-					  fst->hal_rx_fst,
-					  flow_hash,
-					  &rx_flow_info->flow_tuple_info,
-					  &flow_idx);
-	if (status != QDF_STATUS_SUCCESS) {
-		dp_err("Add entry failed with status %d for tuple with hash %u",
-		       status, flow_hash);
-		return NULL;
-	}
+	if (QDF_STATUS_SUCCESS != status)
+		return status;
 
-	fse = dp_rx_flow_get_fse(fst, flow_idx);
-	fse->is_ipv4_addr_entry = rx_flow_info->is_addr_ipv4;
-	fse->flow_hash = flow_hash;
-	fse->flow_id = flow_idx;
-	fse->stats.msdu_count = 0;
-	fse->is_valid = true;
+	/**
+	 * Send HTT cache invalidation command to firmware to reflect the
+	 * added flow, outside the FST lock
+	 */
+	status = dp_rx_flow_batch_invalidate(pdev, rx_flow_info, 1, NULL, 1);
+	if (QDF_STATUS_SUCCESS != status) {
+		dp_err("Send cache invalidate entry to fw failed: %u", status);
+		dp_rx_flow_dump_flow_entry(pdev->rx_fst, rx_flow_info);
+		/* Free DP FSE and HAL FSE */
+		qdf_spin_lock_bh(&fst_ctx->lock);
+		dp_rx_flow_remove_entry(pdev, rx_flow_info);
+		qdf_spin_unlock_bh(&fst_ctx->lock);
+	}
 
-	return fse;
+	return status;
 }
 
 /**
- * dp_rx_flow_find_entry_by_tuple() - Find the DP FSE matching a given 5-tuple
- * @fst: Rx FST Handle
- * @rx_flow_info: DP Rx Flow 5-tuple
- * @flow: Pointer to the  HAL (HW) flow entry
+ * dp_rx_flow_delete_entry() - Delete a flow entry from flow search table
+ * @pdev: pdev handle
+ * @rx_flow_info: DP flow parameters
  *
- * Return: Pointer to the DP FSE entry
+ * Return: Success when flow is deleted, error on failure
  */
-struct dp_rx_fse *
-dp_rx_flow_find_entry_by_tuple(hal_soc_handle_t hal_soc_hdl,
-			       struct dp_rx_fst *fst,
-			       struct cdp_rx_flow_info *rx_flow_info,
-			       struct hal_rx_flow *flow)
+QDF_STATUS dp_rx_flow_delete_entry(struct dp_pdev *pdev,
+				   struct cdp_rx_flow_info *rx_flow_info)
 {
-	uint32_t flow_hash;
-	uint32_t flow_idx;
+	struct dp_rx_fst_ctx *fst_ctx = dp_rx_fst_get_ctx(pdev->rx_fst);
 	QDF_STATUS status;
 
-	flow_hash = dp_rx_flow_compute_flow_hash(fst, rx_flow_info, flow);
+	qdf_spin_lock_bh(&fst_ctx->lock);
+	status = __dp_rx_flow_delete_entry(pdev, rx_flow_info);
+	qdf_spin_unlock_bh(&fst_ctx->lock);
 
-	status = hal_rx_find_flow_from_tuple(hal_soc_hdl,
-					     fst->hal_rx_fst,
-					     flow_hash,
-					     &rx_flow_info->flow_tuple_info,
-					     &flow_idx);
+	if (QDF_STATUS_SUCCESS != status)
+		return status;
 
-	if (status != QDF_STATUS_SUCCESS) {
-		dp_err("Could not find tuple with hash %u", flow_hash);
-		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
-		return NULL;
+	/**
+	 * Send HTT cache invalidation command to firmware to reflect the
+	 * deleted flow, outside the FST lock
+	 */
+	status = dp_rx_flow_batch_invalidate(pdev, rx_flow_info, 1, NULL, 1);
+	if (QDF_STATUS_SUCCESS != status) {
+		dp_err("Send cache invalidate entry to fw failed: %u", status);
+		dp_rx_flow_dump_flow_entry(pdev->rx_fst, rx_flow_info);
+		/* Do not add entry back in DP FSE and HAL FSE */
 	}
-	return dp_rx_flow_get_fse(fst, flow_idx);
+
+	return status;
 }
 
 /**
- * dp_rx_flow_find_entry_by_flowid() - Find DP FSE matching a given flow index
- * @fst: Rx FST Handle
- * @flow_id: Flow index of the requested flow
+ * dp_rx_flow_add_entry_batch() - Add multiple flow entries to flow search
+ *				  table with a single cache invalidate
+ * @pdev: DP pdev instance
+ * @rx_flow_info: Array of DP flow parameters
+ * @num_flows: Number of entries in @rx_flow_info
+ * @status: Per-entry status filled on return
  *
- * Return: Pointer to the DP FSE entry
+ * Return: Success when the batch is processed, even if individual entries
+ *	   failed, error if the cache invalidate could not be sent in which
+ *	   case all entries added by the batch are removed again
  */
-struct dp_rx_fse *
-dp_rx_flow_find_entry_by_flowid(struct dp_rx_fst *fst,
-				uint32_t flow_id)
+QDF_STATUS dp_rx_flow_add_entry_batch(struct dp_pdev *pdev,
+				      struct cdp_rx_flow_info *rx_flow_info,
+				      uint32_t num_flows, QDF_STATUS *status)
 {
-	struct dp_rx_fse *fse = NULL;
+	struct dp_rx_fst_ctx *fst_ctx = dp_rx_fst_get_ctx(pdev->rx_fst);
+	struct dp_rx_fst *fst = pdev->rx_fst;
+	struct hal_rx_flow flow = { 0 };
+	uint32_t *flow_hash;
+	uint32_t num_added;
+	QDF_STATUS ret;
+	uint32_t i;
 
-	fse = dp_rx_flow_get_fse(fst, flow_id);
-	if (!fse->is_valid)
-		return NULL;
+	if (!num_flows)
+		return QDF_STATUS_SUCCESS;
 
-	dp_info("flow_idx= %d, flow_addr = %pK", flow_id, fse);
-	qdf_assert_always(fse->flow_id == flow_id);
+	flow_hash = qdf_mem_malloc(num_flows * sizeof(*flow_hash));
+	if (!flow_hash)
+		return QDF_STATUS_E_NOMEM;
 
-	return fse;
+	/* Compute all hashes first, outside the lock, so the loop stays tight */
+	for (i = 0; i < num_flows; i++) {
+		dp_rx_flow_init_tuple(&rx_flow_info[i]);
+		flow_hash[i] = dp_rx_flow_compute_flow_hash(fst,
+							    &rx_flow_info[i],
+							    &flow);
+	}
+
+	qdf_spin_lock_bh(&fst_ctx->lock);
+	__dp_rx_flow_add_entry_batch(pdev, rx_flow_info, flow_hash, num_flows,
+				     status, &num_added);
+	qdf_spin_unlock_bh(&fst_ctx->lock);
+
+	qdf_mem_free(flow_hash);
+
+	ret = dp_rx_flow_batch_invalidate(pdev, rx_flow_info, num_flows,
+					  status, num_added);
+	if (QDF_STATUS_SUCCESS != ret) {
+		dp_err("Send cache invalidate for %u flows to fw failed: %u",
+		       num_added, ret);
+		/* Free DP FSE and HAL FSE of every entry added above */
+		qdf_spin_lock_bh(&fst_ctx->lock);
+		for (i = 0; i < num_flows; i++) {
+			if (status[i] != QDF_STATUS_SUCCESS)
+				continue;
+
+			dp_rx_flow_remove_entry(pdev, &rx_flow_info[i]);
+			status[i] = ret;
+		}
+		qdf_spin_unlock_bh(&fst_ctx->lock);
+	}
+
+	dp_info("FST batch add %u/%u, num_entries = %d",
+		num_added, num_flows, fst->num_entries);
+
+	return ret;
 }
 
 /**
- * dp_rx_flow_send_htt_operation_cmd() - Send HTT FSE command to FW for flow
- *					 addition/removal
- * @pdev: Pdev instance
- * @op: Add/delete operation
- * @info: DP Flow parameters of the flow added/deleted
+ * dp_rx_flow_delete_entry_batch() - Delete multiple flow entries from flow
+ *				     search table with a single cache invalidate
+ * @pdev: DP pdev instance
+ * @rx_flow_info: Array of DP flow parameters
+ * @num_flows: Number of entries in @rx_flow_info
+ * @status: Per-entry status filled on return
  *
- * Return: Success on sending HTT command to FW, error on failure
+ * Return: Success when the batch is processed, even if individual entries
+ *	   were not found, error if the cache invalidate could not be sent
  */
-QDF_STATUS dp_rx_flow_send_htt_operation_cmd(struct dp_pdev *pdev,
-					     enum dp_htt_flow_fst_operation op,
-					     struct cdp_rx_flow_info *info)
+QDF_STATUS dp_rx_flow_delete_entry_batch(struct dp_pdev *pdev,
+					 struct cdp_rx_flow_info *rx_flow_info,
+					 uint32_t num_flows, QDF_STATUS *status)
 {
-	struct dp_htt_rx_flow_fst_operation fst_op;
-	struct wlan_cfg_dp_soc_ctxt *cfg = pdev->soc->wlan_cfg_ctx;
+	struct dp_rx_fst_ctx *fst_ctx = dp_rx_fst_get_ctx(pdev->rx_fst);
+	uint32_t num_deleted;
+	QDF_STATUS ret;
 
-	qdf_mem_set(&fst_op, 0, sizeof(struct dp_htt_rx_flow_fst_operation));
+	qdf_spin_lock_bh(&fst_ctx->lock);
+	__dp_rx_flow_delete_entry_batch(pdev, rx_flow_info, num_flows, status,
+					&num_deleted);
+	qdf_spin_unlock_bh(&fst_ctx->lock);
 
-	if (qdf_unlikely(wlan_cfg_is_rx_flow_search_table_per_pdev(cfg))) {
-		/* Firmware pdev ID starts from 1 */
-		fst_op.pdev_id = DP_SW2HW_MACID(pdev->pdev_id);
-	} else {
-		fst_op.pdev_id = 0;
-	}
+	ret = dp_rx_flow_batch_invalidate(pdev, rx_flow_info, num_flows,
+					  status, num_deleted);
+	if (QDF_STATUS_SUCCESS != ret)
+		dp_err("Send cache invalidate for %u flows to fw failed: %u",
+		       num_deleted, ret);
 
-	fst_op.op_code = op;
-	fst_op.rx_flow = info;
+	dp_info("FST batch delete %u/%u, num_entries = %d",
+		num_deleted, num_flows, pdev->rx_fst->num_entries);
 
-	return dp_htt_rx_flow_fse_operation(pdev, &fst_op);
+	return ret;
 }
 
 /**
- * dp_rx_flow_add_entry() - Add a flow entry to flow search table
- * @pdev: DP pdev instance
- * @rx_flow_info: DP flow paramaters
+ * dp_rx_fst_aging_timer_handler() - Scan one aging wheel slot and reclaim
+ *				     idle flows
+ * @ctx: FST context
  *
- * Return: Success when flow is added, no-memory or already exists on error
+ * Return: None
  */
-QDF_STATUS dp_rx_flow_add_entry(struct dp_pdev *pdev,
-				struct cdp_rx_flow_info *rx_flow_info)
+static void dp_rx_fst_aging_timer_handler(void *ctx)
 {
-	struct hal_rx_flow flow = { 0 };
+	struct dp_rx_fst_ctx *fst_ctx = (struct dp_rx_fst_ctx *)ctx;
+	struct dp_rx_fst_aging *aging = &fst_ctx->aging;
+	struct dp_rx_fst *fst = &fst_ctx->fst;
+	struct dp_rx_fst_age_entry *age;
+	struct cdp_rx_flow_info *flows = aging->flows;
+	struct cdp_rx_flow_info *info;
+	dp_rx_flow_aging_notify_cb notify_cb;
+	void *notify_ctx;
 	struct dp_rx_fse *fse;
-	struct dp_soc *soc = pdev->soc;
-	struct dp_rx_fst *fst;
+	struct dp_pdev *pdev;
+	struct dp_soc *soc;
+	uint32_t num = 0;
+	uint32_t idx;
+	QDF_STATUS status;
 
-	fst = pdev->rx_fst;
+	qdf_spin_lock_bh(&fst_ctx->lock);
+	if (!aging->enabled) {
+		qdf_spin_unlock_bh(&fst_ctx->lock);
+		return;
+	}
 
-	/* Initialize unused bits in IPv6 address for IPv4 address */
-	if (rx_flow_info->is_addr_ipv4) {
-		rx_flow_info->flow_tuple_info.dest_ip_63_32 = 0;
-		rx_flow_info->flow_tuple_info.dest_ip_95_64 = 0;
-		rx_flow_info->flow_tuple_info.dest_ip_127_96 =
-			HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
+	pdev = aging->pdev;
+	soc = pdev->soc;
+	aging->num_ticks++;
+
+	for (idx = aging->cur_idx;
+	     idx < fst->max_entries && num < DP_RX_FST_AGING_MAX_BATCH;
+	     idx += DP_RX_FST_AGING_WHEEL_SLOTS) {
+		fse = dp_rx_flow_get_fse(fst, idx);
+		if (!fse->is_valid)
+			continue;
+
+		age = &aging->entry[idx];
+		if (fse->stats.msdu_count != age->last_msdu_count) {
+			age->last_msdu_count = fse->stats.msdu_count;
+			age->idle_rounds = 0;
+			continue;
+		}
 
-		rx_flow_info->flow_tuple_info.src_ip_63_32 = 0;
-		rx_flow_info->flow_tuple_info.src_ip_95_64 = 0;
-		rx_flow_info->flow_tuple_info.src_ip_127_96 =
-			HAL_IP_DA_SA_PREFIX_IPV4_COMPATIBLE_IPV6;
-	}
+		if (++age->idle_rounds < DP_RX_FST_AGING_IDLE_ROUNDS)
+			continue;
 
-	/* Allocate entry in DP FST */
-	fse = dp_rx_flow_alloc_entry(soc->hal_soc, fst, rx_flow_info, &flow);
-	if (NULL == fse) {
-		dp_err("RX FSE alloc failed");
-		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
-		return QDF_STATUS_E_NOMEM;
-	}
-	dp_info("flow_addr = %pK, flow_id = %u, valid = %d, v4 = %d\n",
-		fse, fse->flow_id, fse->is_valid, fse->is_ipv4_addr_entry);
+		info = &flows[num++];
+		qdf_mem_zero(info, sizeof(*info));
+		info->flow_tuple_info = fst_ctx->shadow.node[idx].tuple;
+		info->is_addr_ipv4 = fse->is_ipv4_addr_entry;
+		info->op_code = CDP_FLOW_FST_ENTRY_DEL;
 
-	/* Initialize other parameters for HW flow & populate HW FSE entry */
-	flow.reo_destination_indication = (fse->flow_hash &
-				HAL_REO_DEST_IND_HASH_MASK);
+		hal_rx_flow_delete_entry(soc->hal_soc, fst->hal_rx_fst,
+					 fse->hal_rx_fse);
+		dp_rx_fst_shadow_remove(fst, idx);
+		fse->is_valid = false;
+		fst->num_entries--;
+	}
 
-	/**
-	 * Reo destination of each flow is mapped to match the same used
-	 * by RX Hash algorithm. If RX Hash is disabled, then the REO
-	 * destination below is directly got from pdev, rather than using
-	 * dp_peer_setup_get_reo_hash since we do not have vdev handle here.
+	/*
+	 * A slot cut short by the batch limit is resumed on the next tick,
+	 * only a fully scanned slot moves the wheel on.
 	 */
-	if (wlan_cfg_is_rx_hash_enabled(soc->wlan_cfg_ctx)) {
-		flow.reo_destination_indication |=
-			HAL_REO_DEST_IND_START_OFFSET;
+	if (idx < fst->max_entries) {
+		aging->cur_idx = idx;
 	} else {
-		flow.reo_destination_indication = pdev->reo_dest;
+		aging->cur_slot = (aging->cur_slot + 1) &
+				  (DP_RX_FST_AGING_WHEEL_SLOTS - 1);
+		aging->cur_idx = aging->cur_slot;
 	}
 
-	flow.reo_destination_handler = HAL_RX_FSE_REO_DEST_FT;
-	flow.fse_metadata = rx_flow_info->fse_metadata;
-	fse->hal_rx_fse = hal_rx_flow_setup_fse(soc->hal_soc, fst->hal_rx_fst,
-						fse->flow_id, &flow);
-	if (qdf_unlikely(!fse->hal_rx_fse)) {
-		dp_err("Unable to alloc FSE entry");
-		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
-		/* Free up the FSE entry as returning failure */
-		fse->is_valid = false;
-		return QDF_STATUS_E_EXISTS;
+	if (num) {
+		aging->num_reclaimed += num;
+		dp_info("FST aged out %u flows, num_entries = %d", num,
+			fst->num_entries);
 	}
 
-	/* Increment number of valid entries in table */
-	fst->num_entries++;
-	dp_info("FST num_entries = %d, reo_dest_ind = %d, reo_dest_hand = %u",
-		fst->num_entries, flow.reo_destination_indication,
-		flow.reo_destination_handler);
+	notify_cb = aging->notify_cb;
+	notify_ctx = aging->notify_ctx;
+	qdf_spin_unlock_bh(&fst_ctx->lock);
 
-	if (soc->is_rx_fse_full_cache_invalidate_war_enabled) {
-		qdf_atomic_set(&fst->is_cache_update_pending, 1);
-	} else {
-		QDF_STATUS status;
-		/**
-		 * Send HTT cache invalidation command to firmware to
-		 * reflect the added flow
-		 */
-		status = dp_rx_flow_send_htt_operation_cmd(
-					pdev,
-					DP_HTT_FST_CACHE_INVALIDATE_ENTRY,
-					rx_flow_info);
-
-		if (QDF_STATUS_SUCCESS != status) {
-			dp_err("Send cache invalidate entry to fw failed: %u",
-			       status);
-			dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
-			/* Free DP FSE and HAL FSE */
-			hal_rx_flow_delete_entry(soc->hal_soc, fst->hal_rx_fst,
-						 fse->hal_rx_fse);
-			fse->is_valid = false;
-			return status;
-		}
+	if (num) {
+		status = dp_rx_flow_batch_invalidate(pdev, flows, num, NULL,
+						     num);
+		if (QDF_STATUS_SUCCESS != status)
+			dp_err("Send cache invalidate for %u aged flows failed: %u",
+			       num, status);
+
+		if (notify_cb)
+			notify_cb(notify_ctx, flows, num);
+	}
+
+	qdf_timer_start(&aging->timer, aging->tick_ms);
+}
+
+/**
+ * dp_rx_fst_aging_attach() - Allocate the idle flow aging engine
+ * @soc: SoC handle
+ * @fst_ctx: FST context
+ *
+ * Return: Success when allocated, no-memory on error
+ */
+static QDF_STATUS dp_rx_fst_aging_attach(struct dp_soc *soc,
+					 struct dp_rx_fst_ctx *fst_ctx)
+{
+	struct dp_rx_fst_aging *aging = &fst_ctx->aging;
+
+	aging->entry = qdf_mem_malloc(fst_ctx->fst.max_entries *
+				      sizeof(struct dp_rx_fst_age_entry));
+	if (!aging->entry)
+		return QDF_STATUS_E_NOMEM;
+
+	aging->flows = qdf_mem_malloc(DP_RX_FST_AGING_MAX_BATCH *
+				      sizeof(*aging->flows));
+	if (!aging->flows) {
+		qdf_mem_free(aging->entry);
+		aging->entry = NULL;
+		return QDF_STATUS_E_NOMEM;
 	}
 
+	qdf_timer_init(soc->osdev, &aging->timer,
+		       dp_rx_fst_aging_timer_handler, (void *)fst_ctx,
+		       QDF_TIMER_TYPE_SW);
+
 	return QDF_STATUS_SUCCESS;
 }
 
 /**
- * dp_rx_flow_delete_entry() - Delete a flow entry from flow search table
- * @pdev: pdev handle
- * @rx_flow_info: DP flow parameters
+ * dp_rx_fst_aging_detach() - Free the idle flow aging engine
+ * @fst_ctx: FST context
  *
- * Return: Success when flow is deleted, error on failure
+ * Return: None
  */
-QDF_STATUS dp_rx_flow_delete_entry(struct dp_pdev *pdev,
-				   struct cdp_rx_flow_info *rx_flow_info)
+static void dp_rx_fst_aging_detach(struct dp_rx_fst_ctx *fst_ctx)
 {
-	struct hal_rx_flow flow = { 0 };
-	struct dp_rx_fse *fse;
-	struct dp_soc *soc = pdev->soc;
-	struct dp_rx_fst *fst;
-	QDF_STATUS status;
+	struct dp_rx_fst_aging *aging = &fst_ctx->aging;
+
+	aging->enabled = false;
+	qdf_timer_sync_cancel(&aging->timer);
+	qdf_timer_free(&aging->timer);
+	qdf_mem_free(aging->flows);
+	aging->flows = NULL;
+	qdf_mem_free(aging->entry);
+	aging->entry = NULL;
+}
 
-	fst = pdev->rx_fst;
+/**
+ * dp_rx_flow_aging_register() - Enable idle flow aging on the FST
+ * @pdev: DP pdev instance
+ * @idle_timeout_ms: Time without received MSDUs after which a flow is removed
+ * @notify_cb: Callback invoked with the flows removed by aging
+ * @notify_ctx: Context passed to @notify_cb
+ *
+ * Return: Success when aging is enabled, error otherwise
+ */
+QDF_STATUS dp_rx_flow_aging_register(struct dp_pdev *pdev,
+				     uint32_t idle_timeout_ms,
+				     dp_rx_flow_aging_notify_cb notify_cb,
+				     void *notify_ctx)
+{
+	struct dp_rx_fst_ctx *fst_ctx;
+	struct dp_rx_fst_aging *aging;
+	struct dp_rx_fse *fse;
+	uint32_t idx;
 
-	/* Find the given flow entry DP FST */
-	fse = dp_rx_flow_find_entry_by_tuple(soc->hal_soc, fst,
-					     rx_flow_info, &flow);
+	if (!pdev->rx_fst)
+		return QDF_STATUS_E_NOSUPPORT;
 
-	if (!fse) {
-		dp_err("RX flow delete entry failed");
-		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
+	if (!idle_timeout_ms)
 		return QDF_STATUS_E_INVAL;
+
+	fst_ctx = dp_rx_fst_get_ctx(pdev->rx_fst);
+	aging = &fst_ctx->aging;
+
+	qdf_spin_lock_bh(&fst_ctx->lock);
+	aging->pdev = pdev;
+	aging->notify_cb = notify_cb;
+	aging->notify_ctx = notify_ctx;
+	aging->tick_ms = idle_timeout_ms / (DP_RX_FST_AGING_IDLE_ROUNDS *
+					    DP_RX_FST_AGING_WHEEL_SLOTS);
+	if (aging->tick_ms < DP_RX_FST_AGING_MIN_TICK_MS)
+		aging->tick_ms = DP_RX_FST_AGING_MIN_TICK_MS;
+
+	for (idx = 0; idx < fst_ctx->fst.max_entries; idx++) {
+		fse = dp_rx_flow_get_fse(&fst_ctx->fst, idx);
+		aging->entry[idx].last_msdu_count = fse->stats.msdu_count;
+		aging->entry[idx].idle_rounds = 0;
 	}
+	aging->cur_slot = 0;
+	aging->cur_idx = 0;
+	aging->num_reclaimed = 0;
+	aging->num_ticks = 0;
+	aging->enabled = true;
+	qdf_spin_unlock_bh(&fst_ctx->lock);
 
-	/* Delete the FSE in HW FST */
-	status = hal_rx_flow_delete_entry(soc->hal_soc, fst->hal_rx_fst,
-					  fse->hal_rx_fse);
-	qdf_assert_always(status == QDF_STATUS_SUCCESS);
+	qdf_timer_stop(&aging->timer);
+	qdf_timer_start(&aging->timer, aging->tick_ms);
 
-	/* Free the FSE in DP FST */
-	fse->is_valid = false;
+	dp_info("FST aging enabled, idle timeout %u ms, tick %u ms",
+		idle_timeout_ms, aging->tick_ms);
 
-	/* Decrement number of valid entries in table */
-	fst->num_entries--;
+	return QDF_STATUS_SUCCESS;
+}
 
-	if (soc->is_rx_fse_full_cache_invalidate_war_enabled) {
-		qdf_atomic_set(&fst->is_cache_update_pending, 1);
-	} else {
-		/**
-		 * Send HTT cache invalidation command to firmware
-		 * to reflect the deleted flow
-		 */
-		status = dp_rx_flow_send_htt_operation_cmd(
-					pdev,
-					DP_HTT_FST_CACHE_INVALIDATE_ENTRY,
-					rx_flow_info);
-
-		if (QDF_STATUS_SUCCESS != status) {
-			dp_err("Send cache invalidate entry to fw failed: %u",
-			       status);
-			dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
-			/* Do not add entry back in DP FSE and HAL FSE */
-			return status;
-		}
-	}
+/**
+ * dp_rx_flow_aging_unregister() - Disable idle flow aging on the FST
+ * @pdev: DP pdev instance
+ *
+ * Return: Success when aging is disabled, error otherwise
+ */
+QDF_STATUS dp_rx_flow_aging_unregister(struct dp_pdev *pdev)
+{
+	struct dp_rx_fst_ctx *fst_ctx;
+	struct dp_rx_fst_aging *aging;
+
+	if (!pdev->rx_fst)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	fst_ctx = dp_rx_fst_get_ctx(pdev->rx_fst);
+	aging = &fst_ctx->aging;
+
+	qdf_spin_lock_bh(&fst_ctx->lock);
+	aging->enabled = false;
+	aging->notify_cb = NULL;
+	aging->notify_ctx = NULL;
+	qdf_spin_unlock_bh(&fst_ctx->lock);
+
+	qdf_timer_sync_cancel(&aging->timer);
+
+	dp_info("FST aging disabled, reclaimed %llu flows in %llu ticks",
+		aging->num_reclaimed, aging->num_ticks);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -452,13 +1460,11 @@ QDF_STATUS dp_rx_flow_get_fse_stats(struct dp_pdev *pdev,
 	struct dp_soc *soc = pdev->soc;
 	struct dp_rx_fst *fst;
 	struct dp_rx_fse *fse;
-	struct hal_rx_flow flow;
 
 	fst = pdev->rx_fst;
 
 	/* Find the given flow entry DP FST */
-	fse = dp_rx_flow_find_entry_by_tuple(soc->hal_soc, fst,
-					     rx_flow_info, &flow);
+	fse = dp_rx_flow_find_entry_by_shadow(soc->hal_soc, fst, rx_flow_info);
 	if (!fse) {
 		dp_err("RX flow entry search failed");
 		dp_rx_flow_dump_flow_entry(fst, rx_flow_info);
@@ -514,6 +1520,7 @@ void dp_rx_flow_cache_invalidate_timer_handler(void *ctx)
  */
 QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 {
+	struct dp_rx_fst_ctx *fst_ctx;
 	struct dp_rx_fst *fst;
 	uint8_t *hash_key;
 	struct wlan_cfg_dp_soc_ctxt *cfg = soc->wlan_cfg_ctx;
@@ -555,14 +1562,15 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 		return QDF_STATUS_E_EXISTS;
 	}
 
-	fst = qdf_mem_malloc(sizeof(struct dp_rx_fst));
-	if (!fst) {
+	fst_ctx = qdf_mem_malloc(sizeof(struct dp_rx_fst_ctx));
+	if (!fst_ctx) {
 		QDF_TRACE(QDF_MODULE_ID_ANY, QDF_TRACE_LEVEL_ERROR,
 			  "RX FST allocation failed\n");
 		return QDF_STATUS_E_NOMEM;
 	}
 
-	qdf_mem_set(fst, 0, sizeof(struct dp_rx_fst));
+	qdf_mem_set(fst_ctx, 0, sizeof(struct dp_rx_fst_ctx));
+	fst = &fst_ctx->fst;
 
 	fst->max_skid_length = wlan_cfg_rx_fst_get_max_search(cfg);
 	fst->max_entries = wlan_cfg_get_rx_flow_search_table_size(cfg);
@@ -596,9 +1604,30 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 			  "Rx fst->base allocation failed, #entries:%d\n",
 			  fst->max_entries);
 
-		qdf_mem_free(fst);
+		qdf_mem_free(fst_ctx);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	if (dp_rx_fst_shadow_attach(&fst_ctx->shadow, fst->max_entries) !=
+	    QDF_STATUS_SUCCESS) {
+		QDF_TRACE(QDF_MODULE_ID_ANY, QDF_TRACE_LEVEL_ERROR,
+			  "Rx fst shadow allocation failed, #entries:%d\n",
+			  fst->max_entries);
+		qdf_mem_free(fst->base);
+		qdf_mem_free(fst_ctx);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	if (dp_rx_fst_aging_attach(soc, fst_ctx) != QDF_STATUS_SUCCESS) {
+		QDF_TRACE(QDF_MODULE_ID_ANY, QDF_TRACE_LEVEL_ERROR,
+			  "Rx fst aging allocation failed, #entries:%d\n",
+			  fst->max_entries);
+		dp_rx_fst_shadow_detach(&fst_ctx->shadow);
+		qdf_mem_free(fst->base);
+		qdf_mem_free(fst_ctx);
 		return QDF_STATUS_E_NOMEM;
 	}
+	qdf_spinlock_create(&fst_ctx->lock);
 
 	qdf_mem_set((uint8_t *)fst->base, 0,
 		    (sizeof(struct dp_rx_fse) * fst->max_entries));
@@ -615,8 +1644,11 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 		QDF_TRACE(QDF_MODULE_ID_ANY, QDF_TRACE_LEVEL_ERROR,
 			  "Rx Hal fst allocation failed, #entries:%d\n",
 			  fst->max_entries);
+		qdf_spinlock_destroy(&fst_ctx->lock);
+		dp_rx_fst_aging_detach(fst_ctx);
+		dp_rx_fst_shadow_detach(&fst_ctx->shadow);
 		qdf_mem_free(fst->base);
-		qdf_mem_free(fst);
+		qdf_mem_free(fst_ctx);
 		return QDF_STATUS_E_NOMEM;
 	}
 	if (!is_rx_flow_search_table_per_pdev)
@@ -671,6 +1703,8 @@ void dp_rx_fst_detach(struct dp_soc *soc, struct dp_pdev *pdev)
 	}
 
 	if (qdf_likely(dp_fst)) {
+		/* Stop aging first, its timer updates the HAL FST */
+		dp_rx_fst_aging_detach(dp_rx_fst_get_ctx(dp_fst));
 		hal_rx_fst_detach(soc->hal_soc, dp_fst->hal_rx_fst,
 				  soc->osdev, 0);
 		if (soc->is_rx_fse_full_cache_invalidate_war_enabled) {
@@ -678,8 +1712,10 @@ void dp_rx_fst_detach(struct dp_soc *soc, struct dp_pdev *pdev)
 			qdf_timer_stop(&dp_fst->cache_invalidate_timer);
 			qdf_timer_free(&dp_fst->cache_invalidate_timer);
 		}
+		qdf_spinlock_destroy(&dp_rx_fst_get_ctx(dp_fst)->lock);
+		dp_rx_fst_shadow_detach(&dp_rx_fst_get_ctx(dp_fst)->shadow);
 		qdf_mem_free(dp_fst->base);
-		qdf_mem_free(dp_fst);
+		qdf_mem_free(dp_rx_fst_get_ctx(dp_fst));
 	}
 	QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_DEBUG,
 		  "Rx FST detached for pdev %u\n", pdev->pdev_id);
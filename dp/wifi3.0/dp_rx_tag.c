@@ -646,6 +646,58 @@ dp_set_rx_flow_tag(struct cdp_soc_t *soc, uint8_t pdev_id,
 	return QDF_STATUS_E_INVAL;
 }
 
+/**
+ * dp_set_rx_flow_tag_batch - add/delete multiple flows
+ * @soc: soc handle
+ * @pdev_id: id of cdp_pdev handle
+ * @flow_info: array of flow tuples to be added to/deleted from flow search
+ *	       table, all entries must carry the same op_code
+ * @num_flows: number of entries in @flow_info
+ * @status: per-entry status filled on return
+ *
+ * Return: Success when the batch is processed
+ */
+QDF_STATUS
+dp_set_rx_flow_tag_batch(struct cdp_soc_t *soc, uint8_t pdev_id,
+			 struct cdp_rx_flow_info *flow_info,
+			 uint32_t num_flows, QDF_STATUS *status)
+{
+	struct dp_pdev *pdev =
+		dp_get_pdev_from_soc_pdev_id_wifi3((struct dp_soc *)soc,
+						   pdev_id);
+	struct wlan_cfg_dp_soc_ctxt *cfg;
+	uint32_t i;
+
+	if (qdf_unlikely(!pdev || !flow_info || !status))
+		return QDF_STATUS_E_FAILURE;
+
+	cfg = pdev->soc->wlan_cfg_ctx;
+
+	if (qdf_unlikely(!wlan_cfg_is_rx_flow_tag_enabled(cfg))) {
+		dp_err("RX Flow tag feature disabled");
+		return QDF_STATUS_E_NOSUPPORT;
+	}
+
+	if (!num_flows)
+		return QDF_STATUS_SUCCESS;
+
+	for (i = 1; i < num_flows; i++) {
+		if (flow_info[i].op_code != flow_info[0].op_code) {
+			dp_err("Mixed op_code in flow batch at %u", i);
+			return QDF_STATUS_E_INVAL;
+		}
+	}
+
+	if (flow_info[0].op_code == CDP_FLOW_FST_ENTRY_ADD)
+		return dp_rx_flow_add_entry_batch(pdev, flow_info, num_flows,
+						  status);
+	if (flow_info[0].op_code == CDP_FLOW_FST_ENTRY_DEL)
+		return dp_rx_flow_delete_entry_batch(pdev, flow_info,
+						     num_flows, status);
+
+	return QDF_STATUS_E_INVAL;
+}
+
 /**
  * dp_dump_rx_flow_tag_stats - dump the number of packets tagged for
  * given flow 5-tuple
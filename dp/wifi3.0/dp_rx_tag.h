@@ -92,6 +92,22 @@ QDF_STATUS
 dp_set_rx_flow_tag(struct cdp_soc_t *cdp_soc, uint8_t pdev_id,
 		   struct cdp_rx_flow_info *flow_info);
 
+/**
+ * dp_set_rx_flow_tag_batch - add/delete multiple flows
+ * @cdp_soc: soc handle
+ * @pdev_id: id of cdp_pdev handle
+ * @flow_info: array of flow tuples to be added to/deleted from flow search
+ *	       table, all entries must carry the same op_code
+ * @num_flows: number of entries in @flow_info
+ * @status: per-entry status filled on return
+ *
+ * Return: Success when the batch is processed
+ */
+QDF_STATUS
+dp_set_rx_flow_tag_batch(struct cdp_soc_t *cdp_soc, uint8_t pdev_id,
+			 struct cdp_rx_flow_info *flow_info,
+			 uint32_t num_flows, QDF_STATUS *status);
+
 /**
  * dp_dump_rx_flow_tag_stats - dump the number of packets tagged for
  * given flow 5-tuple
@@ -105,6 +121,69 @@ QDF_STATUS
 dp_dump_rx_flow_tag_stats(struct cdp_soc_t *cdp_soc, uint8_t pdev_id,
 			  struct cdp_rx_flow_info *flow_info);
 
+/**
+ * dp_rx_flow_add_entry_batch() - Add multiple flow entries to flow search
+ *				  table with a single cache invalidate
+ * @pdev: DP pdev instance
+ * @rx_flow_info: Array of DP flow parameters
+ * @num_flows: Number of entries in @rx_flow_info
+ * @status: Per-entry status filled on return
+ *
+ * Return: Success when the batch is processed
+ */
+QDF_STATUS dp_rx_flow_add_entry_batch(struct dp_pdev *pdev,
+				      struct cdp_rx_flow_info *rx_flow_info,
+				      uint32_t num_flows, QDF_STATUS *status);
+
+/**
+ * dp_rx_flow_delete_entry_batch() - Delete multiple flow entries from flow
+ *				     search table with a single cache invalidate
+ * @pdev: DP pdev instance
+ * @rx_flow_info: Array of DP flow parameters
+ * @num_flows: Number of entries in @rx_flow_info
+ * @status: Per-entry status filled on return
+ *
+ * Return: Success when the batch is processed
+ */
+QDF_STATUS dp_rx_flow_delete_entry_batch(struct dp_pdev *pdev,
+					 struct cdp_rx_flow_info *rx_flow_info,
+					 uint32_t num_flows, QDF_STATUS *status);
+
+/**
+ * typedef dp_rx_flow_aging_notify_cb - Callback for flows removed by aging
+ * @ctx: Context registered with dp_rx_flow_aging_register
+ * @flow_info: Array of removed flows
+ * @num_flows: Number of entries in @flow_info
+ *
+ * Called from timer context after the flows are removed from the FST.
+ * @flow_info is only valid for the duration of the call.
+ */
+typedef void (*dp_rx_flow_aging_notify_cb)(void *ctx,
+					   struct cdp_rx_flow_info *flow_info,
+					   uint32_t num_flows);
+
+/**
+ * dp_rx_flow_aging_register() - Enable idle flow aging on the FST
+ * @pdev: DP pdev instance
+ * @idle_timeout_ms: Time without received MSDUs after which a flow is removed
+ * @notify_cb: Callback invoked with the flows removed by aging
+ * @notify_ctx: Context passed to @notify_cb
+ *
+ * Return: Success when aging is enabled, error otherwise
+ */
+QDF_STATUS dp_rx_flow_aging_register(struct dp_pdev *pdev,
+				     uint32_t idle_timeout_ms,
+				     dp_rx_flow_aging_notify_cb notify_cb,
+				     void *notify_ctx);
+
+/**
+ * dp_rx_flow_aging_unregister() - Disable idle flow aging on the FST
+ * @pdev: DP pdev instance
+ *
+ * Return: Success when aging is disabled, error otherwise
+ */
+QDF_STATUS dp_rx_flow_aging_unregister(struct dp_pdev *pdev);
+
 /**
  * dp_rx_update_rx_flow_tag_stats() - Update stats for given flow index
  * @pdev: TXRX pdev context for which stats should be incremented
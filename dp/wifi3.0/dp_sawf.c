@@ -229,6 +229,8 @@ dp_sawf_def_queues_get_map_report(struct cdp_soc_t *soc_hdl,
 		dp_sawf_nofl_err("%u        %u            %u",
 				 tid, tid_active, svc_id);
 	}
+	dp_sawf_nofl_err("msduq map fallbacks %u",
+			 sawf_ctx->svc_msduq_fallback);
 
 	dp_peer_unref_delete(peer, DP_MOD_ID_CDP);
 
@@ -434,6 +436,36 @@ dp_sawf_compute_tx_hw_delay_us(struct dp_soc *soc,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * dp_sawf_msduq_delay_bound - get delay bound of an msdu queue
+ * @msduq: SAWF msdu queue
+ *
+ * The service class params are looked up only when they changed since
+ * they were last cached in @msduq.
+ *
+ * Return: delay bound in us, 0 if not configured
+ */
+static inline uint32_t
+dp_sawf_msduq_delay_bound(struct dp_sawf_msduq *msduq)
+{
+	struct wlan_sawf_scv_class_params *svclass_params;
+	uint32_t gen = wlan_sawf_get_generation();
+
+	if (qdf_likely(msduq->svc_gen == gen))
+		return msduq->delay_bound_us;
+
+	msduq->delay_bound_us = 0;
+	if (wlan_delay_bound_configured(msduq->svc_id)) {
+		svclass_params = wlan_get_svc_class_params(msduq->svc_id);
+		if (svclass_params)
+			msduq->delay_bound_us = svclass_params->delay_bound *
+				DP_SAWF_DELAY_BOUND_MS_MULTIPLER;
+	}
+	msduq->svc_gen = gen;
+
+	return msduq->delay_bound_us;
+}
+
 static QDF_STATUS
 dp_sawf_update_tx_delay(struct dp_soc *soc,
 			struct dp_vdev *vdev,
@@ -445,9 +477,9 @@ dp_sawf_update_tx_delay(struct dp_soc *soc,
 			uint8_t host_q_idx)
 {
 	struct sawf_delay_stats *tx_delay;
-	struct wlan_sawf_scv_class_params *svclass_params;
+	struct dp_sawf_msduq *msduq;
 	uint32_t hw_delay;
-	uint8_t svc_id;
+	uint32_t delay_bound;
 	uint32_t num_pkt_win;
 	uint32_t win_avg;
 
@@ -463,8 +495,13 @@ dp_sawf_update_tx_delay(struct dp_soc *soc,
 	tx_delay->num_pkt++;
 	tx_delay->win_total += hw_delay;
 
+	/*
+	 * Windows are tracked with per queue counters reset at the window
+	 * boundary so that the per packet path does not need a modulo.
+	 */
+	msduq = &sawf_ctx->msduq[host_q_idx];
 	num_pkt_win = dp_sawf_get_mov_avg_num_pkt();
-	if (!(tx_delay->num_pkt % num_pkt_win)) {
+	if (++msduq->win_pkt >= num_pkt_win && num_pkt_win) {
 		win_avg = qdf_do_div(tx_delay->win_total, num_pkt_win);
 		/* Update the avg per window */
 		telemetry_sawf_update_delay_mvng(
@@ -472,27 +509,24 @@ dp_sawf_update_tx_delay(struct dp_soc *soc,
 				tid, host_q_idx,
 				win_avg);
 		tx_delay->win_total = 0;
+		msduq->win_pkt = 0;
 	}
 
-	svc_id = sawf_ctx->msduq[host_q_idx].svc_id;
-	if (!wlan_delay_bound_configured(svc_id))
+	delay_bound = dp_sawf_msduq_delay_bound(msduq);
+	if (!delay_bound)
 		goto cont;
 
-	svclass_params = wlan_get_svc_class_params(svc_id);
-	if (svclass_params) {
-		(hw_delay > svclass_params->delay_bound *
-		 DP_SAWF_DELAY_BOUND_MS_MULTIPLER) ?
-			tx_delay->failure++ : tx_delay->success++;
-
-		if (!(tx_delay->num_pkt % dp_sawf_get_sla_num_pkt())) {
-			/* Update the success/failre count */
-			telemetry_sawf_update_delay(sawf_ctx->telemetry_ctx,
-						    tid, host_q_idx,
-						    tx_delay->success,
-						    tx_delay->failure);
-			tx_delay->failure = 0;
-			tx_delay->success = 0;
-		}
+	(hw_delay > delay_bound) ? tx_delay->failure++ : tx_delay->success++;
+
+	if (++msduq->sla_pkt >= dp_sawf_get_sla_num_pkt()) {
+		/* Update the success/failre count */
+		telemetry_sawf_update_delay(sawf_ctx->telemetry_ctx,
+					    tid, host_q_idx,
+					    tx_delay->success,
+					    tx_delay->failure);
+		tx_delay->failure = 0;
+		tx_delay->success = 0;
+		msduq->sla_pkt = 0;
 	}
 
 cont:
@@ -1398,6 +1432,27 @@ process_peer:
 		return DP_SAWF_PEER_Q_INVALID;
 	}
 
+	/*
+	 * Service classes already bound to an msdu queue of the peer are
+	 * found through the direct map, this is the per packet case.
+	 */
+	if (qdf_likely(service_id < DP_SAWF_SVC_MSDUQ_MAP_SIZE)) {
+		q_id = peer->sawf->svc_msduq[service_id];
+		if (qdf_likely(q_id)) {
+			i = q_id - DP_SAWF_DEFAULT_Q_MAX;
+			if (qdf_likely(dp_sawf(peer, i, is_used) &&
+				       dp_sawf(peer, i, svc_id) == service_id)) {
+				dp_sawf(peer, i, ref_count)++;
+				dp_peer_unref_delete(peer, DP_MOD_ID_SAWF);
+				return dp_sawf_msduq_peer_id_set(peer_id, q_id);
+			}
+			/* stale entry, the queue was rebound */
+			peer->sawf->svc_msduq[service_id] = 0;
+		}
+	}
+
+	peer->sawf->svc_msduq_fallback++;
+
 	/*
 	 * First loop to go through all msdu queues of peer which
 	 * have been used. If flow has same service id as that of
@@ -1407,8 +1462,10 @@ process_peer:
 		if ((dp_sawf(peer, i, is_used) == 1) &&
 		    dp_sawf(peer, i, svc_id) == service_id) {
 			dp_sawf(peer, i, ref_count)++;
-			dp_peer_unref_delete(peer, DP_MOD_ID_SAWF);
 			q_id = i + DP_SAWF_DEFAULT_Q_MAX;
+			if (service_id < DP_SAWF_SVC_MSDUQ_MAP_SIZE)
+				peer->sawf->svc_msduq[service_id] = q_id;
+			dp_peer_unref_delete(peer, DP_MOD_ID_SAWF);
 			return dp_sawf_msduq_peer_id_set(peer_id, q_id);
 		}
 	}
@@ -1422,6 +1479,9 @@ process_peer:
 		if (dp_sawf(peer, i, is_used) == 0) {
 			dp_sawf(peer, i, is_used) = 1;
 			dp_sawf(peer, i, svc_id) = service_id;
+			dp_sawf(peer, i, svc_gen) = 0;
+			dp_sawf(peer, i, win_pkt) = 0;
+			dp_sawf(peer, i, sla_pkt) = 0;
 			dp_sawf(peer, i, ref_count)++;
 			if (!peer->sawf->telemetry_ctx) {
 				telemetry_ctx = telemetry_sawf_peer_ctx_alloc(
@@ -1430,8 +1490,10 @@ process_peer:
 				if (telemetry_ctx)
 					peer->sawf->telemetry_ctx = telemetry_ctx;
 			}
-			dp_peer_unref_delete(peer, DP_MOD_ID_SAWF);
 			q_id = i + DP_SAWF_DEFAULT_Q_MAX;
+			if (service_id < DP_SAWF_SVC_MSDUQ_MAP_SIZE)
+				peer->sawf->svc_msduq[service_id] = q_id;
+			dp_peer_unref_delete(peer, DP_MOD_ID_SAWF);
 			return dp_sawf_msduq_peer_id_set(peer_id, q_id);
 		}
 	}
@@ -27,6 +27,7 @@
 #include "cdp_txrx_cmn_struct.h"
 #include "cdp_txrx_hist_struct.h"
 #include "cdp_txrx_extd_struct.h"
+#include <wlan_sawf.h>
 
 #define dp_sawf_alert(params...) \
 	QDF_TRACE_FATAL(QDF_MODULE_ID_DP_SAWF, params)
@@ -83,6 +84,9 @@
 
 #define DP_SAWF_DELAY_BOUND_MS_MULTIPLER 1000
 
+/* service class id to host msdu queue map, indexed by service class id */
+#define DP_SAWF_SVC_MSDUQ_MAP_SIZE (SAWF_SVC_CLASS_MAX + 1)
+
 /**
  * sawf_stats - sawf stats
  * @delay: delay stats per host msdu queue
@@ -360,6 +364,21 @@ QDF_STATUS
 dp_sawf_get_peer_tx_stats(struct cdp_soc_t *soc,
 			  uint32_t svc_id, uint8_t *mac, void *data);
 
+/**
+ * struct dp_sawf_msduq - SAWF msdu queue
+ * @ref_count: number of flows mapped to the queue
+ * @htt_msduq: target msdu queue index
+ * @remapped_tid: tid the queue is remapped to
+ * @is_used: queue is allotted to a service class
+ * @del_in_progress: queue deletion is in progress
+ * @tx_flow_number: tx flow number
+ * @svc_id: service class id
+ * @svc_gen: service class params generation @delay_bound_us was taken at,
+ *	     0 if nothing is cached
+ * @delay_bound_us: cached delay bound in us, 0 if not configured
+ * @win_pkt: packets completed in the current moving average window
+ * @sla_pkt: packets completed in the current SLA window
+ */
 struct dp_sawf_msduq {
 	uint8_t ref_count;
 	uint8_t htt_msduq;
@@ -368,12 +387,25 @@ struct dp_sawf_msduq {
 	bool del_in_progress;
 	uint32_t tx_flow_number;
 	uint32_t svc_id;
+	uint32_t svc_gen;
+	uint32_t delay_bound_us;
+	uint32_t win_pkt;
+	uint32_t sla_pkt;
 };
 
 struct dp_sawf_msduq_tid_map {
 	uint8_t host_queue_id;
 };
 
+/**
+ * struct dp_peer_sawf - peer SAWF context
+ * @msduq: SAWF msdu queues
+ * @msduq_map: tid and target queue to host msdu queue map
+ * @tid_reports: default queue map reports per tid
+ * @telemetry_ctx: telemetry agent peer context
+ * @svc_msduq: host msdu queue id bound to each service class, 0 if none
+ * @svc_msduq_fallback: msdu queue selections not served by @svc_msduq
+ */
 struct dp_peer_sawf {
 	/* qdf_bitmap queue_usage; */
 	struct dp_sawf_msduq msduq[DP_SAWF_Q_MAX];
@@ -381,6 +413,8 @@ struct dp_peer_sawf {
 	       msduq_map[DP_SAWF_TID_MAX][DP_SAWF_DEFINED_Q_PTID_MAX];
 	struct sawf_def_queue_report tid_reports[DP_SAWF_TID_MAX];
 	void *telemetry_ctx;
+	uint8_t svc_msduq[DP_SAWF_SVC_MSDUQ_MAP_SIZE];
+	uint32_t svc_msduq_fallback;
 };
 
 uint16_t dp_sawf_get_msduq(struct net_device *netdev, uint8_t *peer_mac,
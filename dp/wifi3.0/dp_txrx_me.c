@@ -32,6 +32,65 @@
 #define ME_CLEAN_WAIT_TIMEOUT (200000) /*200ms*/
 #define ME_CLEAN_WAIT_COUNT 400
 
+/**
+ * dp_tx_me_seg_pool_alloc() - Allocate the segment descriptor pools
+ * @seg_pool: array of DP_TX_ME_SEG_POOL_NUM pool pointers to fill
+ *
+ * Pools that cannot be allocated are left NULL, conversions then use
+ * per-segment allocation more often.
+ *
+ * Return: void
+ */
+static void dp_tx_me_seg_pool_alloc(struct dp_tx_me_seg_pool **seg_pool)
+{
+	uint8_t i;
+
+	for (i = 0; i < DP_TX_ME_SEG_POOL_NUM; i++)
+		seg_pool[i] = qdf_mem_malloc(sizeof(**seg_pool));
+}
+
+/**
+ * dp_tx_me_seg_pool_free() - Free the segment descriptor pools
+ * @seg_pool: array of DP_TX_ME_SEG_POOL_NUM pool pointers
+ *
+ * Return: void
+ */
+static void dp_tx_me_seg_pool_free(struct dp_tx_me_seg_pool **seg_pool)
+{
+	uint8_t i;
+
+	for (i = 0; i < DP_TX_ME_SEG_POOL_NUM; i++) {
+		if (!seg_pool[i])
+			continue;
+
+		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO,
+			  "ME seg pool %u hit %d miss %d", i,
+			  qdf_atomic_read(&seg_pool[i]->hit),
+			  qdf_atomic_read(&seg_pool[i]->miss));
+		qdf_mem_free(seg_pool[i]);
+		seg_pool[i] = NULL;
+	}
+}
+
+/**
+ * dp_tx_me_seg_pool_busy() - Check if a conversion still owns a pool
+ * @me_ctx: ME buffer pool context
+ *
+ * Return: true if any pool is claimed
+ */
+static bool dp_tx_me_seg_pool_busy(struct dp_tx_me_pool_ctx *me_ctx)
+{
+	uint8_t i;
+
+	for (i = 0; i < DP_TX_ME_SEG_POOL_NUM; i++) {
+		if (me_ctx->seg_pool[i] &&
+		    qdf_atomic_read(&me_ctx->seg_pool[i]->in_use))
+			return true;
+	}
+
+	return false;
+}
+
 /**
  * dp_tx_me_init():Initialize ME buffer ppol
  * @pdev: DP PDEV handle
@@ -43,6 +102,10 @@ dp_tx_me_init(struct dp_pdev *pdev)
 {
 	uint16_t i, mc_uc_buf_len, num_pool_elems;
 	uint32_t pool_size;
+	struct dp_tx_me_pool_ctx *me_ctx;
+	struct dp_tx_me_seg_pool *seg_pool[DP_TX_ME_SEG_POOL_NUM];
+	qdf_dma_addr_t paddr = 0;
+	QDF_STATUS status;
 
 	struct dp_tx_me_buf_t *p;
 
@@ -53,17 +116,22 @@ dp_tx_me_init(struct dp_pdev *pdev)
 	pool_size = (mc_uc_buf_len) * num_pool_elems;
 	pdev->me_buf.size = mc_uc_buf_len;
 	if (!(pdev->me_buf.vaddr)) {
+		/* segment pools are large, allocate them outside the lock */
+		dp_tx_me_seg_pool_alloc(seg_pool);
 		qdf_spin_lock_bh(&pdev->tx_mutex);
-		pdev->me_buf.vaddr = qdf_mem_malloc(pool_size);
+		pdev->me_buf.vaddr = qdf_mem_malloc(sizeof(*me_ctx) +
+						    pool_size);
 		if (!(pdev->me_buf.vaddr)) {
 			qdf_spin_unlock_bh(&pdev->tx_mutex);
+			dp_tx_me_seg_pool_free(seg_pool);
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO,
 			  "Error allocating memory pool");
 			return 1;
 		}
+		me_ctx = (struct dp_tx_me_pool_ctx *)pdev->me_buf.vaddr;
+		qdf_mem_copy(me_ctx->seg_pool, seg_pool, sizeof(seg_pool));
 		pdev->me_buf.buf_in_use = 0;
-		pdev->me_buf.freelist =
-			(struct dp_tx_me_buf_t *)pdev->me_buf.vaddr;
+		pdev->me_buf.freelist = me_ctx->bufs;
 		/*
 		 * me_buf looks like this
 		 * |=======+==========================|
@@ -77,6 +145,20 @@ dp_tx_me_init(struct dp_pdev *pdev)
 			p = p->next;
 		}
 		p->next = NULL;
+
+		/*
+		 * Map the MAC buffers once so that the per-packet path
+		 * only needs a cache sync after writing the destination.
+		 * Per-buffer mapping is used if this fails.
+		 */
+		status = qdf_mem_map_nbytes_single(pdev->soc->osdev,
+						   me_ctx->bufs,
+						   QDF_DMA_TO_DEVICE,
+						   pool_size, &paddr);
+		if (QDF_IS_STATUS_SUCCESS(status)) {
+			pdev->me_buf.paddr = paddr;
+			me_ctx->buf_mapped = true;
+		}
 		qdf_spin_unlock_bh(&pdev->tx_mutex);
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO,
 			  "ME Pool successfully initialized vaddr - %pK",
@@ -96,6 +178,130 @@ dp_tx_me_init(struct dp_pdev *pdev)
 	return 0;
 }
 
+/**
+ * dp_tx_me_seg_pool_claim() - Take ownership of a free segment pool
+ * @pdev: DP PDEV handle
+ *
+ * The search starts at the pool of the current CPU so that concurrent
+ * conversions rarely contend. The pool is claimed under tx_mutex, which
+ * dp_tx_me_exit() holds while it frees the pools.
+ *
+ * Return: claimed pool or NULL
+ */
+static struct dp_tx_me_seg_pool *
+dp_tx_me_seg_pool_claim(struct dp_pdev *pdev)
+{
+	struct dp_tx_me_pool_ctx *me_ctx;
+	struct dp_tx_me_seg_pool *seg_pool = NULL;
+	uint8_t i, idx;
+
+	qdf_spin_lock_bh(&pdev->tx_mutex);
+	me_ctx = (struct dp_tx_me_pool_ctx *)pdev->me_buf.vaddr;
+	if (qdf_likely(me_ctx)) {
+		idx = qdf_get_cpu() % DP_TX_ME_SEG_POOL_NUM;
+		for (i = 0; i < DP_TX_ME_SEG_POOL_NUM; i++) {
+			if (me_ctx->seg_pool[idx] &&
+			    !qdf_atomic_cmpxchg(&me_ctx->seg_pool[idx]->in_use,
+						0, 1)) {
+				seg_pool = me_ctx->seg_pool[idx];
+				break;
+			}
+			idx = (idx + 1) % DP_TX_ME_SEG_POOL_NUM;
+		}
+	}
+	qdf_spin_unlock_bh(&pdev->tx_mutex);
+
+	return seg_pool;
+}
+
+/**
+ * dp_tx_me_seg_pool_release() - Release ownership of the vdev segment pool
+ * @seg_pool: pool returned by dp_tx_me_seg_pool_claim
+ *
+ * Return: void
+ */
+static inline void dp_tx_me_seg_pool_release(struct dp_tx_me_seg_pool *seg_pool)
+{
+	if (seg_pool)
+		qdf_atomic_set(&seg_pool->in_use, 0);
+}
+
+/**
+ * dp_tx_me_seg_alloc() - Get a segment descriptor for a destination
+ * @seg_pool: claimed pool or NULL
+ * @idx: index of the segment in the current conversion
+ *
+ * Return: segment descriptor or NULL
+ */
+static inline struct dp_tx_seg_info_s *
+dp_tx_me_seg_alloc(struct dp_tx_me_seg_pool *seg_pool, uint8_t idx)
+{
+	if (qdf_likely(seg_pool)) {
+		if (qdf_likely(idx < DP_TX_ME_SEG_POOL_SIZE)) {
+			qdf_atomic_inc(&seg_pool->hit);
+			return &seg_pool->segs[idx];
+		}
+		qdf_atomic_inc(&seg_pool->miss);
+	}
+
+	return qdf_mem_malloc(sizeof(struct dp_tx_seg_info_s));
+}
+
+/**
+ * dp_tx_me_seg_free() - Free a segment descriptor
+ * @seg_pool: claimed pool or NULL
+ * @seg: segment descriptor
+ *
+ * Return: void
+ */
+static inline void
+dp_tx_me_seg_free(struct dp_tx_me_seg_pool *seg_pool,
+		  struct dp_tx_seg_info_s *seg)
+{
+	if (seg_pool && seg >= seg_pool->segs &&
+	    seg < &seg_pool->segs[DP_TX_ME_SEG_POOL_SIZE])
+		return;
+
+	qdf_mem_free(seg);
+}
+
+/**
+ * dp_tx_me_map_buf() - Get the DMA address of a destination MAC buffer
+ * @pdev: DP PDEV handle
+ * @mc_uc_buf: ME buffer holding the destination MAC
+ * @paddr: DMA address of the MAC
+ *
+ * Buffers from a pre-mapped pool only need a sync to the device. Their
+ * paddr_macbuf is left 0 so that tx completion does not unmap them.
+ *
+ * Return: QDF_STATUS
+ */
+static inline QDF_STATUS
+dp_tx_me_map_buf(struct dp_pdev *pdev, struct dp_tx_me_buf_t *mc_uc_buf,
+		 qdf_dma_addr_t *paddr)
+{
+	struct dp_tx_me_pool_ctx *me_ctx =
+		(struct dp_tx_me_pool_ctx *)pdev->me_buf.vaddr;
+	QDF_STATUS status;
+
+	if (qdf_likely(me_ctx && me_ctx->buf_mapped)) {
+		*paddr = pdev->me_buf.paddr +
+			 ((uint8_t *)mc_uc_buf->data - (uint8_t *)me_ctx->bufs);
+		qdf_mem_dma_sync_single_for_device(pdev->soc->osdev, *paddr,
+						   QDF_MAC_ADDR_SIZE,
+						   QDF_DMA_TO_DEVICE);
+		mc_uc_buf->paddr_macbuf = 0;
+		return QDF_STATUS_SUCCESS;
+	}
+
+	status = qdf_mem_map_nbytes_single(pdev->soc->osdev, mc_uc_buf->data,
+					   QDF_DMA_TO_DEVICE, QDF_MAC_ADDR_SIZE,
+					   paddr);
+	mc_uc_buf->paddr_macbuf = QDF_IS_STATUS_SUCCESS(status) ? *paddr : 0;
+
+	return status;
+}
+
 /**
  * dp_tx_me_alloc_descriptor():Allocate ME descriptor
  * @soc: DP SOC handle
@@ -136,18 +342,26 @@ dp_tx_me_exit(struct dp_pdev *pdev)
 
 	if (pdev->me_buf.vaddr) {
 		uint16_t wait_cnt = 0;
+		struct dp_tx_me_pool_ctx *me_ctx;
 
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO,
 			  "Disabling Mcastenhance,This may take some time");
 		qdf_spin_lock_bh(&pdev->tx_mutex);
-		while ((pdev->me_buf.buf_in_use > 0) &&
+		me_ctx = (struct dp_tx_me_pool_ctx *)pdev->me_buf.vaddr;
+		/*
+		 * A conversion in progress may own a segment pool without
+		 * holding any ME buffer yet, wait for both to drain.
+		 */
+		while (((pdev->me_buf.buf_in_use > 0) ||
+			dp_tx_me_seg_pool_busy(me_ctx)) &&
 		       (wait_cnt < ME_CLEAN_WAIT_COUNT)) {
 			qdf_spin_unlock_bh(&pdev->tx_mutex);
 			OS_SLEEP(ME_CLEAN_WAIT_TIMEOUT);
 			wait_cnt++;
 			qdf_spin_lock_bh(&pdev->tx_mutex);
 		}
-		if (pdev->me_buf.buf_in_use > 0) {
+		if ((pdev->me_buf.buf_in_use > 0) ||
+		    dp_tx_me_seg_pool_busy(me_ctx)) {
 			QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_FATAL,
 				  "Tx-comp pending for %d",
 				  pdev->me_buf.buf_in_use);
@@ -157,6 +371,14 @@ dp_tx_me_exit(struct dp_pdev *pdev)
 			qdf_assert_always(0);
 		}
 
+		dp_tx_me_seg_pool_free(me_ctx->seg_pool);
+		if (me_ctx->buf_mapped)
+			qdf_mem_unmap_nbytes_single(pdev->soc->osdev,
+						    pdev->me_buf.paddr,
+						    QDF_DMA_TO_DEVICE,
+						    pdev->me_buf.size *
+						    MAX_ME_BUF_CHUNK);
+		pdev->me_buf.paddr = 0;
 		qdf_mem_free(pdev->me_buf.vaddr);
 		pdev->me_buf.vaddr = NULL;
 		pdev->me_buf.freelist = NULL;
@@ -232,32 +454,36 @@ dp_tx_prepare_send_igmp_me(struct dp_vdev *vdev, qdf_nbuf_t nbuf)
 /*
  * dp_tx_me_mem_free(): Function to free allocated memory in mcast enahncement
  * pdev: pointer to DP PDEV structure
+ * seg_pool: segment pool owned by the conversion or NULL
  * seg_info_head: Pointer to the head of list
  *
  * return: void
  */
 static void dp_tx_me_mem_free(struct dp_pdev *pdev,
+			      struct dp_tx_me_seg_pool *seg_pool,
 			      struct dp_tx_seg_info_s *seg_info_head)
 {
 	struct dp_tx_me_buf_t *mc_uc_buf;
 	struct dp_tx_seg_info_s *seg_info_new = NULL;
 	qdf_nbuf_t nbuf = NULL;
-	uint64_t phy_addr;
 
 	while (seg_info_head) {
 		nbuf = seg_info_head->nbuf;
 		mc_uc_buf = (struct dp_tx_me_buf_t *)
 			seg_info_head->frags[0].vaddr;
-		phy_addr = seg_info_head->frags[0].paddr_hi;
-		phy_addr =  (phy_addr << 32) | seg_info_head->frags[0].paddr_lo;
-		qdf_mem_unmap_nbytes_single(pdev->soc->osdev,
-					    phy_addr,
-					    QDF_DMA_TO_DEVICE, QDF_MAC_ADDR_SIZE);
+		/* buffers from the pre-mapped pool have paddr_macbuf 0 */
+		if (mc_uc_buf->paddr_macbuf) {
+			qdf_mem_unmap_nbytes_single(pdev->soc->osdev,
+						    mc_uc_buf->paddr_macbuf,
+						    QDF_DMA_TO_DEVICE,
+						    QDF_MAC_ADDR_SIZE);
+			mc_uc_buf->paddr_macbuf = 0;
+		}
 		dp_tx_me_free_buf(pdev, mc_uc_buf);
 		qdf_nbuf_free(nbuf);
 		seg_info_new = seg_info_head;
 		seg_info_head = seg_info_head->next;
-		qdf_mem_free(seg_info_new);
+		dp_tx_me_seg_free(seg_pool, seg_info_new);
 	}
 }
 
@@ -378,6 +604,7 @@ dp_tx_me_send_convert_ucast(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	struct dp_tx_seg_info_s *seg_info_head = NULL;
 	struct dp_tx_seg_info_s *seg_info_tail = NULL;
 	struct dp_tx_seg_info_s *seg_info_new;
+	struct dp_tx_me_seg_pool *seg_pool = NULL;
 	qdf_dma_addr_t paddr_data;
 	qdf_dma_addr_t paddr_mcbuf = 0;
 	uint8_t empty_entry_mac[QDF_MAC_ADDR_SIZE] = {0};
@@ -421,6 +648,8 @@ dp_tx_me_send_convert_ucast(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 	paddr_data = qdf_nbuf_mapped_paddr_get(nbuf) + QDF_MAC_ADDR_SIZE;
 
+	seg_pool = dp_tx_me_seg_pool_claim(pdev);
+
 	for (new_mac_idx = 0; new_mac_idx < new_mac_cnt; new_mac_idx++) {
 		dstmac = newmac[new_mac_idx];
 		QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO,
@@ -434,11 +663,7 @@ dp_tx_me_send_convert_ucast(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		if (!qdf_mem_cmp(dstmac, srcmac, QDF_MAC_ADDR_SIZE))
 			continue;
 
-		/*
-		 * optimize to avoid malloc in per-packet path
-		 * For eg. seg_pool can be made part of vdev structure
-		 */
-		seg_info_new = qdf_mem_malloc(sizeof(*seg_info_new));
+		seg_info_new = dp_tx_me_seg_alloc(seg_pool, curr_mac_cnt);
 
 		if (!seg_info_new) {
 			QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
@@ -472,18 +697,14 @@ dp_tx_me_send_convert_ucast(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 		qdf_mem_copy(mc_uc_buf->data, dstmac, QDF_MAC_ADDR_SIZE);
 
-		status = qdf_mem_map_nbytes_single(vdev->osdev, mc_uc_buf->data,
-				QDF_DMA_TO_DEVICE, QDF_MAC_ADDR_SIZE,
-				&paddr_mcbuf);
+		status = dp_tx_me_map_buf(pdev, mc_uc_buf, &paddr_mcbuf);
 
 		if (status) {
 			QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_ERROR,
 					"Mapping failure Error:%d", status);
 			DP_STATS_INC(vdev, tx_i.mcast_en.dropped_map_error, 1);
-			mc_uc_buf->paddr_macbuf = 0;
 			goto fail_map;
 		}
-		mc_uc_buf->paddr_macbuf = paddr_mcbuf;
 		seg_info_new->frags[0].vaddr =  (uint8_t *)mc_uc_buf;
 		seg_info_new->frags[0].paddr_lo = (uint32_t) paddr_mcbuf;
 		seg_info_new->frags[0].paddr_hi =
@@ -539,12 +760,12 @@ dp_tx_me_send_convert_ucast(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 	dp_tx_send_msdu_multiple(vdev, nbuf, &msdu_info);
 
-	while (seg_info_head->next) {
+	while (seg_info_head) {
 		seg_info_new = seg_info_head;
 		seg_info_head = seg_info_head->next;
-		qdf_mem_free(seg_info_new);
+		dp_tx_me_seg_free(seg_pool, seg_info_new);
 	}
-	qdf_mem_free(seg_info_head);
+	dp_tx_me_seg_pool_release(seg_pool);
 
 	qdf_nbuf_free(nbuf);
 	dp_vdev_unref_delete(soc, vdev, DP_MOD_ID_MCAST2UCAST);
@@ -557,12 +778,13 @@ fail_clone:
 	dp_tx_me_free_buf(pdev, mc_uc_buf);
 
 fail_buf_alloc:
-	qdf_mem_free(seg_info_new);
+	dp_tx_me_seg_free(seg_pool, seg_info_new);
 
 fail_seg_alloc:
-	dp_tx_me_mem_free(pdev, seg_info_head);
+	dp_tx_me_mem_free(pdev, seg_pool, seg_info_head);
 
 unmap_free_return:
+	dp_tx_me_seg_pool_release(seg_pool);
 	qdf_nbuf_unmap(pdev->soc->osdev, nbuf, QDF_DMA_TO_DEVICE);
 free_return:
 	if (vdev)
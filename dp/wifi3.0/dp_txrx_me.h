@@ -27,6 +27,58 @@ typedef struct dp_vdev_dms_me {
 	uint16_t			 num_pkt_sent;
 } dp_vdev_dms_me_t;
 
+/*
+ * ME client limit: maximum number of destinations of one mcast to ucast
+ * conversion. dp_tx_me_send_convert_ucast() takes the destination count
+ * as a uint8_t, so no conversion can exceed this.
+ */
+#ifndef DP_TX_ME_MAX_CLIENTS
+#define DP_TX_ME_MAX_CLIENTS UINT8_MAX
+#endif
+
+/*
+ * Number of segment descriptors in one pool for mcast to ucast conversion,
+ * one per ME client. Builds that lower DP_TX_ME_MAX_CLIENTS below the
+ * caller's real limit fall back to per-segment allocation for the excess
+ * destinations.
+ */
+#define DP_TX_ME_SEG_POOL_SIZE DP_TX_ME_MAX_CLIENTS
+
+/*
+ * Number of segment pools allocated per pdev when ME is enabled. A
+ * conversion that finds every pool busy falls back to per-segment
+ * allocation.
+ */
+#ifndef DP_TX_ME_SEG_POOL_NUM
+#define DP_TX_ME_SEG_POOL_NUM 4
+#endif
+
+/**
+ * struct dp_tx_me_seg_pool - segment descriptor pool
+ * @in_use: set while a conversion owns the pool
+ * @hit: segments served from the pool
+ * @miss: segments allocated on the slow path
+ * @segs: pre-allocated segment descriptors
+ */
+struct dp_tx_me_seg_pool {
+	qdf_atomic_t in_use;
+	qdf_atomic_t hit;
+	qdf_atomic_t miss;
+	struct dp_tx_seg_info_s segs[DP_TX_ME_SEG_POOL_SIZE];
+};
+
+/**
+ * struct dp_tx_me_pool_ctx - ME buffer pool memory layout
+ * @seg_pool: segment descriptor pools, claimed under pdev tx_mutex
+ * @buf_mapped: true if @bufs are DMA mapped as a single region
+ * @bufs: destination MAC buffers, linked into pdev me_buf freelist
+ */
+struct dp_tx_me_pool_ctx {
+	struct dp_tx_me_seg_pool *seg_pool[DP_TX_ME_SEG_POOL_NUM];
+	bool buf_mapped;
+	struct dp_tx_me_buf_t bufs[];
+};
+
 #ifndef QCA_HOST_MODE_WIFI_DISABLED
 
 uint16_t
@@ -54,17 +54,24 @@
 #define DP_RX_MON_CCE_FSE_METADATA_SIZE \
 	((DP_RX_MON_CCE_METADATA_SIZE) + (DP_RX_MON_FSE_METADATA_SIZE))
 
+/* peers are hashed on the low mac bytes, size must be a power of 2 */
+#define DP_LITE_MON_PEER_HASH_SIZE 16
+#define DP_LITE_MON_PEER_HASH(_mac) \
+	(((_mac)[3] ^ (_mac)[4] ^ (_mac)[5]) & (DP_LITE_MON_PEER_HASH_SIZE - 1))
+
 /**
  * dp_lite_mon_peer - lite mon peer structure
  * @peer_mac: mac addr of peer
  * @rssi: rssi of peer(used only in case of non-assoc peer)
  * @type: assoc/non-assoc
  * @peer_list_elem: list element
+ * @peer_hash_elem: hash bucket list element
  */
 struct dp_lite_mon_peer {
 	union dp_align_mac_addr peer_mac;
 	uint8_t rssi;
 	TAILQ_ENTRY(dp_lite_mon_peer) peer_list_elem;
+	TAILQ_ENTRY(dp_lite_mon_peer) peer_hash_elem;
 };
 
 /**
@@ -84,6 +91,7 @@ struct dp_lite_mon_peer {
  * @lite_mon_vdev: output vdev ctx
  * @peer_count: assoc/non-assoc peer count
  * @peer_list: lite mon peer list
+ * @peer_hash: lite mon peers hashed on mac address
  */
 struct dp_lite_mon_config {
 	bool enable;
@@ -101,6 +109,7 @@ struct dp_lite_mon_config {
 	struct dp_vdev *lite_mon_vdev;
 	uint8_t peer_count;
 	TAILQ_HEAD(, dp_lite_mon_peer) peer_list;
+	TAILQ_HEAD(, dp_lite_mon_peer) peer_hash[DP_LITE_MON_PEER_HASH_SIZE];
 };
 
 /**
@@ -40,7 +40,10 @@ struct dp_tx_desc_s;
 
 #define RTS_INTERVAL 40
 
+/* Size of the open addressed peer filter table, must be a power of 2 */
 #define MAX_MGMT_PEER_FILTER 16
+#define MGMT_PEER_FILTER_HASH(_mac) \
+	(((_mac)[3] ^ (_mac)[4] ^ (_mac)[5]) & (MAX_MGMT_PEER_FILTER - 1))
 
 /* Macro for Debugfs */
 #define TX_CAP_DBG_FILE_PERM	(QDF_FILE_USR_READ | QDF_FILE_USR_WRITE | \
@@ -146,10 +149,14 @@ struct dp_pdev_tx_capture {
 	uint32_t pend_ppdu_dropped;
 	qdf_nbuf_queue_t ctl_mgmt_q[TXCAP_MAX_TYPE][TXCAP_MAX_SUBTYPE];
 	qdf_nbuf_queue_t retries_ctl_mgmt_q[TXCAP_MAX_TYPE][TXCAP_MAX_SUBTYPE];
+	/* truesize sum of each retries_ctl_mgmt_q, kept with the memory limit */
+	uint32_t retries_ctl_mgmt_bytes[TXCAP_MAX_TYPE][TXCAP_MAX_SUBTYPE];
 	qdf_spinlock_t ctl_mgmt_lock[TXCAP_MAX_TYPE][TXCAP_MAX_SUBTYPE];
 	uint32_t htt_frame_type[TX_CAP_HTT_MAX_FTYPE];
 	struct cdp_tx_completion_ppdu *dummy_ppdu_desc;
 	struct dp_peer_mgmt_list *ptr_peer_mgmt_list;
+	/* number of used entries in ptr_peer_mgmt_list */
+	uint8_t peer_mgmt_filter_cnt;
 	qdf_atomic_t tx_cap_usr_mode;
 	struct tx_cap_debug_log_info log_info;
 	struct dp_tx_cap_nbuf_list *last_nbuf_ppdu_list;
@@ -184,6 +191,8 @@ struct dp_tx_tid {
 	uint32_t last_deq_ms;
 	uint32_t last_processed_ms;
 	qdf_atomic_t msdu_comp_bytes;
+	/* truesize sum of defer_msdu_q, protected by tid_lock */
+	uint32_t defer_msdu_bytes;
 };
 
 struct dp_peer_tx_capture {
@@ -35,6 +35,48 @@
 #include <dp_be.h>
 #include <dp_rx_mon_2.0.h>
 
+/**
+ * dp_lite_mon_peer_hash_init - init lite mon peer hash buckets
+ * @config: lite mon tx/rx config
+ *
+ * Return: void
+ */
+static inline void
+dp_lite_mon_peer_hash_init(struct dp_lite_mon_config *config)
+{
+	uint8_t i;
+
+	for (i = 0; i < DP_LITE_MON_PEER_HASH_SIZE; i++)
+		TAILQ_INIT(&config->peer_hash[i]);
+}
+
+/**
+ * dp_lite_mon_find_peer - find lite mon peer by mac address
+ * @config: lite mon tx/rx config
+ * @mac: peer mac address
+ *
+ * Caller must hold the lite mon tx/rx lock
+ *
+ * Return: peer if found, NULL otherwise
+ */
+static inline struct dp_lite_mon_peer *
+dp_lite_mon_find_peer(struct dp_lite_mon_config *config, uint8_t *mac)
+{
+	struct dp_lite_mon_peer *peer;
+
+	if (!config->peer_count)
+		return NULL;
+
+	TAILQ_FOREACH(peer, &config->peer_hash[DP_LITE_MON_PEER_HASH(mac)],
+		      peer_hash_elem) {
+		if (!qdf_mem_cmp(&peer->peer_mac.raw[0], mac,
+				 QDF_MAC_ADDR_SIZE))
+			return peer;
+	}
+
+	return NULL;
+}
+
 /**
  * dp_lite_mon_free_peers - free peers
  * @config: lite mon tx/rx config
@@ -51,6 +93,9 @@ dp_lite_mon_free_peers(struct dp_lite_mon_config *config)
 			   peer_list_elem, temp_peer) {
 		/* delete peer from the list */
 		TAILQ_REMOVE(&config->peer_list, peer, peer_list_elem);
+		TAILQ_REMOVE(&config->peer_hash[DP_LITE_MON_PEER_HASH(
+							peer->peer_mac.raw)],
+			     peer, peer_hash_elem);
 		config->peer_count--;
 		qdf_mem_free(peer);
 	}
@@ -575,7 +620,7 @@ dp_lite_mon_update_peers(struct dp_lite_mon_config *config,
 			 struct dp_lite_mon_peer *new_peer)
 {
 	struct dp_lite_mon_peer *peer;
-	bool peer_deleted = false;
+	uint8_t hash = DP_LITE_MON_PEER_HASH(peer_config->mac);
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 
 	if (peer_config->action == CDP_LITE_MON_PEER_ADD) {
@@ -584,14 +629,10 @@ dp_lite_mon_update_peers(struct dp_lite_mon_config *config,
 			return QDF_STATUS_E_NOMEM;
 		}
 
-		TAILQ_FOREACH(peer, &config->peer_list,
-			      peer_list_elem) {
-			if (!qdf_mem_cmp(&peer->peer_mac.raw[0],
-					 peer_config->mac, QDF_MAC_ADDR_SIZE)) {
-				dp_mon_err("%pM Peer already exist",
-					   peer_config->mac);
-				return QDF_STATUS_E_ALREADY;
-			}
+		if (dp_lite_mon_find_peer(config, peer_config->mac)) {
+			dp_mon_err("%pM Peer already exist",
+				   peer_config->mac);
+			return QDF_STATUS_E_ALREADY;
 		}
 
 		qdf_mem_copy(&new_peer->peer_mac.raw[0],
@@ -600,22 +641,20 @@ dp_lite_mon_update_peers(struct dp_lite_mon_config *config,
 		/* add peer to lite mon peer list */
 		TAILQ_INSERT_TAIL(&config->peer_list,
 				  new_peer, peer_list_elem);
+		TAILQ_INSERT_TAIL(&config->peer_hash[hash],
+				  new_peer, peer_hash_elem);
 		config->peer_count++;
 	} else if (peer_config->action == CDP_LITE_MON_PEER_REMOVE) {
-		TAILQ_FOREACH(peer, &config->peer_list,
-			      peer_list_elem) {
-			if (!qdf_mem_cmp(&peer->peer_mac.raw[0],
-					 peer_config->mac, QDF_MAC_ADDR_SIZE)) {
-				/* delete peer from lite mon peer list */
-				TAILQ_REMOVE(&config->peer_list,
-					     peer, peer_list_elem);
-				config->peer_count--;
-				qdf_mem_free(peer);
-				peer_deleted = true;
-				break;
-			}
-		}
-		if (!peer_deleted) {
+		peer = dp_lite_mon_find_peer(config, peer_config->mac);
+		if (peer) {
+			/* delete peer from lite mon peer list */
+			TAILQ_REMOVE(&config->peer_list,
+				     peer, peer_list_elem);
+			TAILQ_REMOVE(&config->peer_hash[hash],
+				     peer, peer_hash_elem);
+			config->peer_count--;
+			qdf_mem_free(peer);
+		} else {
 			status = QDF_STATUS_E_FAILURE;
 			dp_mon_err("%pM Cannot find peer to delete",
 					   peer_config->mac);
@@ -1150,14 +1189,10 @@ dp_lite_mon_get_nac_peer_rssi(struct cdp_soc_t *soc_hdl,
 	lite_mon_rx_config = be_mon_pdev->lite_mon_rx_config;
 	rx_config = &lite_mon_rx_config->rx_config;
 	qdf_spin_lock_bh(&lite_mon_rx_config->lite_mon_rx_lock);
-	TAILQ_FOREACH(peer, &rx_config->peer_list, peer_list_elem) {
-		if (qdf_mem_cmp(&peer->peer_mac.raw[0],
-				macaddr,
-				QDF_MAC_ADDR_SIZE) == 0) {
-			*rssi = peer->rssi;
-			status = QDF_STATUS_SUCCESS;
-			break;
-		}
+	peer = dp_lite_mon_find_peer(rx_config, (uint8_t *)macaddr);
+	if (peer) {
+		*rssi = peer->rssi;
+		status = QDF_STATUS_SUCCESS;
 	}
 	qdf_spin_unlock_bh(&lite_mon_rx_config->lite_mon_rx_lock);
 	dp_vdev_unref_delete(soc, vdev, DP_MOD_ID_CDP);
@@ -1689,17 +1724,12 @@ dp_lite_mon_rx_mpdu_process(struct dp_pdev *pdev,
 	 * first mpdu as rssi is at ppdu level */
 	if (mpdu_id == 0 &&
 	    config->peer_count) {
-		struct dp_lite_mon_peer *peer = NULL;
-
-		TAILQ_FOREACH(peer, &config->peer_list,
-			      peer_list_elem) {
-			if (!qdf_mem_cmp(&peer->peer_mac,
-					 &ppdu_info->nac_info.mac_addr2,
-					 QDF_MAC_ADDR_SIZE)) {
-				peer->rssi = ppdu_info->rx_status.rssi_comb;
-				break;
-			}
-		}
+		struct dp_lite_mon_peer *peer;
+
+		peer = dp_lite_mon_find_peer(config,
+					     ppdu_info->nac_info.mac_addr2);
+		if (peer)
+			peer->rssi = ppdu_info->rx_status.rssi_comb;
 	}
 
 	/* if level is PPDU we need only first MPDU, drop others
@@ -1808,6 +1838,7 @@ QDF_STATUS dp_lite_mon_rx_alloc(struct dp_mon_pdev_be *be_mon_pdev)
 	}
 
 	TAILQ_INIT(&be_mon_pdev->lite_mon_rx_config->rx_config.peer_list);
+	dp_lite_mon_peer_hash_init(&be_mon_pdev->lite_mon_rx_config->rx_config);
 	qdf_spinlock_create(&be_mon_pdev->lite_mon_rx_config->lite_mon_rx_lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -1830,6 +1861,7 @@ QDF_STATUS dp_lite_mon_tx_alloc(struct dp_mon_pdev_be *be_mon_pdev)
 	}
 
 	TAILQ_INIT(&be_mon_pdev->lite_mon_tx_config->tx_config.peer_list);
+	dp_lite_mon_peer_hash_init(&be_mon_pdev->lite_mon_tx_config->tx_config);
 	qdf_spinlock_create(&be_mon_pdev->lite_mon_tx_config->lite_mon_tx_lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -349,6 +349,31 @@ void dp_tx_capture_print_stats(struct dp_peer *peer)
 }
 #endif
 
+/**
+ * dp_tx_capt_retries_q_flush() - free a mgmt retry queue and release its
+ *				  bytes from the tx capture memory usage
+ * @pdev: DP PDEV handle
+ * @type: frame type index of the queue
+ * @subtype: frame subtype index of the queue
+ * @mem_limit_flag: tx capture memory limit is enabled
+ *
+ * Return: void
+ */
+static inline
+void dp_tx_capt_retries_q_flush(struct dp_pdev *pdev, uint8_t type,
+				uint8_t subtype, bool mem_limit_flag)
+{
+	struct dp_mon_soc *mon_soc = pdev->soc->monitor_soc;
+	struct dp_pdev_tx_capture *tx_capture;
+
+	tx_capture = &pdev->monitor_pdev->tx_capture;
+	if (mem_limit_flag)
+		qdf_atomic_sub(tx_capture->retries_ctl_mgmt_bytes[type][subtype],
+			       &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
+	tx_capture->retries_ctl_mgmt_bytes[type][subtype] = 0;
+	TX_CAP_NBUF_QUEUE_FREE(&tx_capture->retries_ctl_mgmt_q[type][subtype]);
+}
+
 #define DP_TX_PEER_DEL_REF(peer) \
 	dp_tx_peer_del_ref(__func__, __LINE__, peer)
 
@@ -823,6 +848,7 @@ void dp_peer_tid_queue_init(struct dp_peer *peer)
 		qdf_spinlock_create(&tx_tid->tid_lock);
 		qdf_spinlock_create(&tx_tid->tasklet_tid_lock);
 		qdf_atomic_init(&tx_tid->msdu_comp_bytes);
+		tx_tid->defer_msdu_bytes = 0;
 	}
 
 	mon_peer->tx_capture.is_tid_initialized = 1;
@@ -901,10 +927,10 @@ void dp_peer_tx_cap_tid_queue_flush(struct dp_soc *soc, struct dp_peer *peer,
 		xretry_user = &xretry_ppdu->user[0];
 
 		qdf_spin_lock_bh(&tx_tid->tid_lock);
-		if (wlan_cfg_get_tx_capt_max_mem(pdev->soc->wlan_cfg_ctx) &&
-		    !qdf_nbuf_is_queue_empty(&tx_tid->defer_msdu_q)) {
-			nbytes = dp_tx_capt_get_q_bytes(&tx_tid->defer_msdu_q);
-			qdf_atomic_sub(nbytes, &mon_soc->dp_soc_tx_capt.ppdu_bytes);
+		if (wlan_cfg_get_tx_capt_max_mem(pdev->soc->wlan_cfg_ctx)) {
+			qdf_atomic_sub(tx_tid->defer_msdu_bytes,
+				       &mon_soc->dp_soc_tx_capt.ppdu_bytes);
+			tx_tid->defer_msdu_bytes = 0;
 		}
 		TX_CAP_NBUF_QUEUE_FREE(&tx_tid->defer_msdu_q);
 		/* update last dequeue time with current msec */
@@ -1013,10 +1039,10 @@ void dp_peer_tid_queue_cleanup(struct dp_peer *peer)
 		xretry_user = &xretry_ppdu->user[0];
 
 		qdf_spin_lock_bh(&tx_tid->tid_lock);
-		if (wlan_cfg_get_tx_capt_max_mem(pdev->soc->wlan_cfg_ctx) &&
-		    !qdf_nbuf_is_queue_empty(&tx_tid->defer_msdu_q)) {
-			uint32_t nbytes = dp_tx_capt_get_q_bytes(&tx_tid->defer_msdu_q);
-			qdf_atomic_sub(nbytes, &mon_soc->dp_soc_tx_capt.ppdu_bytes);
+		if (wlan_cfg_get_tx_capt_max_mem(pdev->soc->wlan_cfg_ctx)) {
+			qdf_atomic_sub(tx_tid->defer_msdu_bytes,
+				       &mon_soc->dp_soc_tx_capt.ppdu_bytes);
+			tx_tid->defer_msdu_bytes = 0;
 		}
 		TX_CAP_NBUF_QUEUE_FREE(&tx_tid->defer_msdu_q);
 		qdf_spin_unlock_bh(&tx_tid->tid_lock);
@@ -1343,6 +1369,41 @@ static inline int dp_peer_compare_mac_addr(void *addr1, void *addr2)
 		 & (mac_addr1->align4.bytes_ef == mac_addr2->align4.bytes_ef));
 }
 
+/*
+ * dp_peer_tx_cap_filter_find: find the slot of a mac address in the peer
+ * mgmt filter table
+ * @tx_capture: pdev tx capture context
+ * @mac_addr: pointer to mac address
+ *
+ * The table is open addressed: an entry lives at MGMT_PEER_FILTER_HASH()
+ * of its mac address or at the first free slot probing forward from it,
+ * so a lookup stops at the first free slot it meets.
+ *
+ * return: slot index on match and MAX_MGMT_PEER_FILTER if not found
+ */
+static uint8_t
+dp_peer_tx_cap_filter_find(struct dp_pdev_tx_capture *tx_capture,
+			   uint8_t *mac_addr)
+{
+	struct dp_peer_mgmt_list *ptr_peer_mgmt_list;
+	uint8_t idx = MGMT_PEER_FILTER_HASH(mac_addr);
+	uint8_t i = 0;
+
+	for (i = 0; i < MAX_MGMT_PEER_FILTER; i++) {
+		ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[idx];
+		if (ptr_peer_mgmt_list->avail)
+			break;
+
+		if (!dp_peer_compare_mac_addr(mac_addr,
+					      ptr_peer_mgmt_list->mac_addr))
+			return idx;
+
+		idx = (idx + 1) & (MAX_MGMT_PEER_FILTER - 1);
+	}
+
+	return MAX_MGMT_PEER_FILTER;
+}
+
 /*
  * dp_peer_tx_cap_search: filter mgmt pkt based on peer and mac address
  * @pdev: DP PDEV handle
@@ -1356,33 +1417,19 @@ bool dp_peer_tx_cap_search(struct dp_pdev *pdev,
 			   uint16_t peer_id, uint8_t *mac_addr)
 {
 	struct dp_pdev_tx_capture *tx_capture;
-	struct dp_peer_mgmt_list *ptr_peer_mgmt_list;
-	uint8_t i = 0;
-	bool found = false;
 	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
 
 	tx_capture = &mon_pdev->tx_capture;
 
-	if (!tx_capture || !(tx_capture->ptr_peer_mgmt_list)) {
-		return found;
-	}
-
-	/* search based on mac address */
-	for (i = 0; i < MAX_MGMT_PEER_FILTER; i++) {
-		uint8_t *peer_mac_addr;
+	if (!tx_capture || !(tx_capture->ptr_peer_mgmt_list))
+		return false;
 
-		ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[i];
-		if (ptr_peer_mgmt_list->avail)
-			continue;
+	/* nothing to match when no peer filter is configured */
+	if (!tx_capture->peer_mgmt_filter_cnt)
+		return false;
 
-		peer_mac_addr = ptr_peer_mgmt_list->mac_addr;
-		if (!dp_peer_compare_mac_addr(mac_addr,
-					      peer_mac_addr)) {
-			found = true;
-			break;
-		}
-	}
-	return found;
+	return dp_peer_tx_cap_filter_find(tx_capture, mac_addr) <
+		MAX_MGMT_PEER_FILTER;
 }
 
 /*
@@ -1399,6 +1446,7 @@ bool dp_peer_tx_cap_add_filter(struct dp_pdev *pdev,
 {
 	struct dp_pdev_tx_capture *tx_capture;
 	struct dp_peer_mgmt_list *ptr_peer_mgmt_list;
+	uint8_t idx;
 	uint8_t i = 0;
 	bool status = false;
 	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
@@ -1412,14 +1460,18 @@ bool dp_peer_tx_cap_add_filter(struct dp_pdev *pdev,
 		return status;
 	}
 
+	idx = MGMT_PEER_FILTER_HASH(mac_addr);
 	for (i = 0; i < MAX_MGMT_PEER_FILTER; i++) {
-		ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[i];
-		if (!ptr_peer_mgmt_list->avail)
+		ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[idx];
+		if (!ptr_peer_mgmt_list->avail) {
+			idx = (idx + 1) & (MAX_MGMT_PEER_FILTER - 1);
 			continue;
+		}
 		qdf_mem_copy(ptr_peer_mgmt_list->mac_addr,
 			     mac_addr, QDF_MAC_ADDR_SIZE);
 		ptr_peer_mgmt_list->avail = false;
 		ptr_peer_mgmt_list->peer_id = peer_id;
+		tx_capture->peer_mgmt_filter_cnt++;
 		status = true;
 		break;
 	}
@@ -1451,6 +1503,7 @@ void dp_peer_tx_cap_del_all_filter(struct dp_pdev *pdev)
 		ptr_peer_mgmt_list->peer_id = HTT_INVALID_PEER;
 		qdf_mem_zero(ptr_peer_mgmt_list->mac_addr, QDF_MAC_ADDR_SIZE);
 	}
+	tx_capture->peer_mgmt_filter_cnt = 0;
 }
 
 /*
@@ -1460,6 +1513,9 @@ void dp_peer_tx_cap_del_all_filter(struct dp_pdev *pdev)
  * @peer_id: DP PEER ID
  * @mac_addr: pointer to mac address
  *
+ * Entries following the deleted one in its probe chain are shifted back
+ * so that lookups, which stop at the first free slot, still reach them.
+ *
  * return: true on added and false on not failed
  */
 bool dp_peer_tx_cap_del_filter(struct dp_pdev *pdev,
@@ -1467,30 +1523,48 @@ bool dp_peer_tx_cap_del_filter(struct dp_pdev *pdev,
 {
 	struct dp_pdev_tx_capture *tx_capture;
 	struct dp_peer_mgmt_list *ptr_peer_mgmt_list;
+	struct dp_peer_mgmt_list *hole_list;
+	uint8_t hole;
+	uint8_t idx;
+	uint8_t home;
 	uint8_t i = 0;
-	bool status = false;
 	struct dp_mon_pdev *mon_pdev = pdev->monitor_pdev;
 
 	tx_capture = &mon_pdev->tx_capture;
 
-	for (i = 0; i < MAX_MGMT_PEER_FILTER; i++) {
-		ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[i];
-		if (!dp_peer_compare_mac_addr(mac_addr,
-					      ptr_peer_mgmt_list->mac_addr) &&
-		    (!ptr_peer_mgmt_list->avail)) {
-			ptr_peer_mgmt_list->avail = true;
-			ptr_peer_mgmt_list->peer_id = HTT_INVALID_PEER;
-			qdf_mem_zero(ptr_peer_mgmt_list->mac_addr,
-				     QDF_MAC_ADDR_SIZE);
-			status = true;
+	hole = dp_peer_tx_cap_filter_find(tx_capture, mac_addr);
+	if (hole >= MAX_MGMT_PEER_FILTER) {
+		dp_tx_capture_info("%pK: unable to delete peer[%d] mac[%pM] filter list",
+				   pdev->soc, peer_id, mac_addr);
+		return false;
+	}
+
+	idx = hole;
+	for (i = 1; i < MAX_MGMT_PEER_FILTER; i++) {
+		idx = (idx + 1) & (MAX_MGMT_PEER_FILTER - 1);
+		ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[idx];
+		if (ptr_peer_mgmt_list->avail)
 			break;
-		}
+
+		/* keep the entry if its home slot lies in (hole, idx] */
+		home = MGMT_PEER_FILTER_HASH(ptr_peer_mgmt_list->mac_addr);
+		if (((idx - home) & (MAX_MGMT_PEER_FILTER - 1)) <
+		    ((idx - hole) & (MAX_MGMT_PEER_FILTER - 1)))
+			continue;
+
+		hole_list = &tx_capture->ptr_peer_mgmt_list[hole];
+		qdf_mem_copy(hole_list, ptr_peer_mgmt_list,
+			     sizeof(struct dp_peer_mgmt_list));
+		hole = idx;
 	}
 
-	if (!status)
-		dp_tx_capture_info("%pK: unable to delete peer[%d] mac[%pM] filter list",
-				   pdev->soc, peer_id, mac_addr);
-	return status;
+	ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[hole];
+	ptr_peer_mgmt_list->avail = true;
+	ptr_peer_mgmt_list->peer_id = HTT_INVALID_PEER;
+	qdf_mem_zero(ptr_peer_mgmt_list->mac_addr, QDF_MAC_ADDR_SIZE);
+	tx_capture->peer_mgmt_filter_cnt--;
+
+	return true;
 }
 
 /*
@@ -1691,6 +1765,7 @@ void dp_tx_ppdu_stats_attach_1_0(struct dp_pdev *pdev)
 				&mon_pdev->tx_capture.retries_ctl_mgmt_q[i][j]);
 			qdf_nbuf_queue_init(
 				&mon_pdev->tx_capture.retries_ctl_mgmt_q[i][j]);
+			mon_pdev->tx_capture.retries_ctl_mgmt_bytes[i][j] = 0;
 		}
 	}
 
@@ -1711,6 +1786,7 @@ void dp_tx_ppdu_stats_attach_1_0(struct dp_pdev *pdev)
 		ptr_peer_mgmt_list = &tx_capture->ptr_peer_mgmt_list[i];
 		ptr_peer_mgmt_list->avail = true;
 	}
+	tx_capture->peer_mgmt_filter_cnt = 0;
 
 	ppdu_desc_dbg_queue_init(ptr_log_info);
 }
@@ -1786,13 +1862,11 @@ void dp_tx_ppdu_stats_detach_1_0(struct dp_pdev *pdev)
 			retries_q =
 				&mon_pdev->tx_capture.retries_ctl_mgmt_q[i][j];
 
-			if (!qdf_nbuf_is_queue_empty(retries_q)) {
-				if (wlan_cfg_get_tx_capt_max_mem(pdev->soc->wlan_cfg_ctx)) {
-					uint32_t nbytes = dp_tx_capt_get_q_bytes(retries_q);
-					qdf_atomic_sub(nbytes, &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
-				}
-				TX_CAP_NBUF_QUEUE_FREE(retries_q);
-			}
+			if (!qdf_nbuf_is_queue_empty(retries_q))
+				dp_tx_capt_retries_q_flush(
+					pdev, i, j,
+					wlan_cfg_get_tx_capt_max_mem(
+						pdev->soc->wlan_cfg_ctx));
 		}
 	}
 
@@ -2420,13 +2494,9 @@ dp_enh_tx_capture_disable(struct dp_pdev *pdev)
 				&mon_pdev->tx_capture.ctl_mgmt_lock[i][j]);
 			retries_q =
 				&mon_pdev->tx_capture.retries_ctl_mgmt_q[i][j];
-			if (!qdf_nbuf_is_queue_empty(retries_q)) {
-				if (mem_limit_flag) {
-					nbytes = dp_tx_capt_get_q_bytes(retries_q);
-					qdf_atomic_sub(nbytes, &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
-				}
-				TX_CAP_NBUF_QUEUE_FREE(retries_q);
-			}
+			if (!qdf_nbuf_is_queue_empty(retries_q))
+				dp_tx_capt_retries_q_flush(pdev, i, j,
+							   mem_limit_flag);
 		}
 	}
 
@@ -3152,6 +3222,8 @@ uint32_t dp_tx_msdu_dequeue(struct dp_peer *peer, uint32_t ppdu_id,
 	uint32_t wbm_tsf = 0xffff;
 	uint32_t matched = 0;
 	qdf_nbuf_queue_t temp_defer_q;
+	uint32_t temp_defer_bytes = 0;
+	uint32_t nbytes;
 	struct dp_soc *soc = NULL;
 	struct dp_mon_soc *mon_soc = NULL;
 
@@ -3181,7 +3253,8 @@ uint32_t dp_tx_msdu_dequeue(struct dp_peer *peer, uint32_t ppdu_id,
 	qdf_nbuf_queue_append(&temp_defer_q, &tx_tid->msdu_comp_q);
 
 	if (wlan_cfg_get_tx_capt_max_mem(soc->wlan_cfg_ctx)) {
-		qdf_atomic_add(qdf_atomic_read(&tx_tid->msdu_comp_bytes),
+		temp_defer_bytes = qdf_atomic_read(&tx_tid->msdu_comp_bytes);
+		qdf_atomic_add(temp_defer_bytes,
 			       &mon_soc->dp_soc_tx_capt.ppdu_bytes);
 		qdf_atomic_set(&tx_tid->msdu_comp_bytes, 0);
 	}
@@ -3194,6 +3267,7 @@ uint32_t dp_tx_msdu_dequeue(struct dp_peer *peer, uint32_t ppdu_id,
 	qdf_spin_lock_bh(&tx_tid->tid_lock);
 
 	qdf_nbuf_queue_append(&tx_tid->defer_msdu_q, &temp_defer_q);
+	tx_tid->defer_msdu_bytes += temp_defer_bytes;
 
 	if (qdf_nbuf_is_queue_empty(&tx_tid->defer_msdu_q)) {
 		/* release lock here */
@@ -3221,7 +3295,9 @@ uint32_t dp_tx_msdu_dequeue(struct dp_peer *peer, uint32_t ppdu_id,
 			/* Frames removed due to excessive retries */
 			qdf_nbuf_queue_remove(&tx_tid->defer_msdu_q);
 			if (wlan_cfg_get_tx_capt_max_mem(soc->wlan_cfg_ctx)) {
-				qdf_atomic_sub(qdf_nbuf_get_truesize(curr_msdu),
+				nbytes = qdf_nbuf_get_truesize(curr_msdu);
+				tx_tid->defer_msdu_bytes -= nbytes;
+				qdf_atomic_sub(nbytes,
 					       &mon_soc->dp_soc_tx_capt.ppdu_bytes);
 			}
 			qdf_nbuf_queue_add(head_xretries, curr_msdu);
@@ -3243,7 +3319,9 @@ uint32_t dp_tx_msdu_dequeue(struct dp_peer *peer, uint32_t ppdu_id,
 			/* remove the aged packet */
 			qdf_nbuf_queue_remove(&tx_tid->defer_msdu_q);
 			if (wlan_cfg_get_tx_capt_max_mem(soc->wlan_cfg_ctx)) {
-				qdf_atomic_sub(qdf_nbuf_get_truesize(curr_msdu),
+				nbytes = qdf_nbuf_get_truesize(curr_msdu);
+				tx_tid->defer_msdu_bytes -= nbytes;
+				qdf_atomic_sub(nbytes,
 					       &mon_soc->dp_soc_tx_capt.ppdu_bytes);
 			}
 
@@ -3258,7 +3336,9 @@ uint32_t dp_tx_msdu_dequeue(struct dp_peer *peer, uint32_t ppdu_id,
 			/* remove head */
 			qdf_nbuf_queue_remove(&tx_tid->defer_msdu_q);
 			if (wlan_cfg_get_tx_capt_max_mem(soc->wlan_cfg_ctx)) {
-				qdf_atomic_sub(qdf_nbuf_get_truesize(curr_msdu),
+				nbytes = qdf_nbuf_get_truesize(curr_msdu);
+				tx_tid->defer_msdu_bytes -= nbytes;
+				qdf_atomic_sub(nbytes,
 					       &mon_soc->dp_soc_tx_capt.ppdu_bytes);
 			}
 			/* add msdu to head queue */
@@ -4739,6 +4819,7 @@ dp_check_mgmt_ctrl_ppdu(struct dp_pdev *pdev,
 	bool is_sgen_pkt;
 	struct cdp_tx_mgmt_comp_info *ptr_comp_info;
 	qdf_nbuf_queue_t *retries_q;
+	uint32_t *retries_bytes;
 	struct cdp_tx_completion_ppdu *ppdu_desc, *retry_ppdu;
 	struct cdp_tx_completion_ppdu_user *user;
 	uint32_t ppdu_id;
@@ -4844,20 +4925,17 @@ dp_check_mgmt_ctrl_ppdu(struct dp_pdev *pdev,
 	}
 
 	retries_q = &mon_pdev->tx_capture.retries_ctl_mgmt_q[type][subtype];
+	retries_bytes =
+		&mon_pdev->tx_capture.retries_ctl_mgmt_bytes[type][subtype];
 
 	if (!qdf_nbuf_is_queue_empty(retries_q)) {
 		tmp_nbuf  = qdf_nbuf_queue_first(retries_q);
 		retry_ppdu = (struct cdp_tx_completion_ppdu *)
 			      qdf_nbuf_data(tmp_nbuf);
 
-		if (ppdu_desc->sched_cmdid != retry_ppdu->sched_cmdid) {
-			if (mem_limit_flag) {
-				uint32_t nbytes = dp_tx_capt_get_q_bytes(retries_q);
-				qdf_atomic_sub(nbytes,
-					       &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
-			}
-			TX_CAP_NBUF_QUEUE_FREE(retries_q);
-		}
+		if (ppdu_desc->sched_cmdid != retry_ppdu->sched_cmdid)
+			dp_tx_capt_retries_q_flush(pdev, type, subtype,
+						   mem_limit_flag);
 	}
 
 get_mgmt_pkt_from_queue:
@@ -4950,6 +5028,8 @@ get_mgmt_pkt_from_queue:
 
 				if (mem_limit_flag) {
 					if (qdf_likely(nbuf_retry_ppdu)) {
+						*retries_bytes -=
+						qdf_nbuf_get_truesize(nbuf_retry_ppdu);
 						qdf_atomic_sub(qdf_nbuf_get_truesize(nbuf_retry_ppdu),
 								   &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
 					}
@@ -4968,6 +5048,8 @@ get_mgmt_pkt_from_queue:
 				} else {
 					qdf_atomic_add(qdf_nbuf_get_truesize(nbuf_ppdu_desc),
 						       &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
+					*retries_bytes +=
+					qdf_nbuf_get_truesize(nbuf_ppdu_desc);
 					qdf_nbuf_queue_add(retries_q, nbuf_ppdu_desc);
 				}
 			} else {
@@ -4983,12 +5065,8 @@ get_mgmt_pkt_from_queue:
 			 */
 			if (qdf_unlikely(ppdu_desc->user[0].completion_status ==
 					 HTT_PPDU_STATS_USER_STATUS_OK)) {
-				if (mem_limit_flag) {
-					uint32_t nbytes = dp_tx_capt_get_q_bytes(retries_q);
-					qdf_atomic_sub(nbytes,
-						       &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
-				}
-				TX_CAP_NBUF_QUEUE_FREE(retries_q);
+				dp_tx_capt_retries_q_flush(pdev, type, subtype,
+							   mem_limit_flag);
 			}
 
 			status = QDF_STATUS_SUCCESS;
@@ -5053,12 +5131,9 @@ insert_mgmt_buf_to_queue:
 					qdf_nbuf_free(nbuf_ppdu_desc);
 					qdf_nbuf_free(mgmt_ctl_nbuf);
 
-					if (mem_limit_flag) {
-						uint32_t nbytes = dp_tx_capt_get_q_bytes(retries_q);
-						qdf_atomic_sub(nbytes,
-							       &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
-					}
-					TX_CAP_NBUF_QUEUE_FREE(retries_q);
+					dp_tx_capt_retries_q_flush(
+							pdev, type, subtype,
+							mem_limit_flag);
 					status = QDF_STATUS_SUCCESS;
 					goto exit;
 				}
@@ -5084,6 +5159,8 @@ insert_mgmt_buf_to_queue:
 				}
 
 				if (wlan_cfg_get_tx_capt_max_mem(pdev->soc->wlan_cfg_ctx)) {
+					*retries_bytes -=
+					qdf_nbuf_get_truesize(nbuf_retry_ppdu);
 					qdf_atomic_sub(qdf_nbuf_get_truesize(nbuf_retry_ppdu),
 							&mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
 				}
@@ -5183,6 +5260,8 @@ insert_mgmt_buf_to_queue:
 
 			if (mem_limit_flag) {
 				if (qdf_likely(nbuf_retry_ppdu)) {
+					*retries_bytes -=
+					qdf_nbuf_get_truesize(nbuf_retry_ppdu);
 					qdf_atomic_sub(qdf_nbuf_get_truesize(nbuf_retry_ppdu),
 						&mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
 				}
@@ -5201,6 +5280,8 @@ insert_mgmt_buf_to_queue:
 			} else {
 				qdf_atomic_add(qdf_nbuf_get_truesize(nbuf_ppdu_desc),
 							&mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
+				*retries_bytes +=
+					qdf_nbuf_get_truesize(nbuf_ppdu_desc);
 				qdf_nbuf_queue_add(retries_q, nbuf_ppdu_desc);
 			}
 		} else {
@@ -5216,12 +5297,8 @@ insert_mgmt_buf_to_queue:
 		 */
 		if (qdf_unlikely(ppdu_desc->user[0].completion_status ==
 				 HTT_PPDU_STATS_USER_STATUS_OK)) {
-			if (mem_limit_flag) {
-				uint32_t nbytes = dp_tx_capt_get_q_bytes(retries_q);
-				qdf_atomic_sub(nbytes,
-					       &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
-			}
-			TX_CAP_NBUF_QUEUE_FREE(retries_q);
+			dp_tx_capt_retries_q_flush(pdev, type, subtype,
+						   mem_limit_flag);
 		}
 
 		status = QDF_STATUS_SUCCESS;
@@ -6192,14 +6269,9 @@ dp_pdev_tx_cap_flush(struct dp_pdev *pdev, bool is_stats_queue_empty)
 			 */
 			retries_q =
 				&mon_pdev->tx_capture.retries_ctl_mgmt_q[i][j];
-			if (!qdf_nbuf_is_queue_empty(retries_q)) {
-				if (mem_limit_flag) {
-					uint32_t nbytes = dp_tx_capt_get_q_bytes(retries_q);
-					qdf_atomic_sub(nbytes,
-						       &mon_soc->dp_soc_tx_capt.ppdu_mgmt_bytes);
-				}
-				TX_CAP_NBUF_QUEUE_FREE(retries_q);
-			}
+			if (!qdf_nbuf_is_queue_empty(retries_q))
+				dp_tx_capt_retries_q_flush(pdev, i, j,
+							   mem_limit_flag);
 		}
 	}
 
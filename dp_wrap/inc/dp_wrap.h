@@ -304,6 +304,7 @@ void dp_wrap_vdev_set_wrap(struct wlan_objmgr_vdev *vdev);
 void dp_wrap_vdev_clear_wrap(struct wlan_objmgr_vdev *vdev);
 void dp_wrap_dev_remove(struct wlan_objmgr_vdev *vdev);
 void dp_wrap_dev_remove_vma(struct wlan_objmgr_vdev *vdev);
+void dp_wrap_devt_hash_stats(struct wlan_objmgr_pdev *pdev);
 int dp_wrap_rx_process(struct net_device **dev, struct wlan_objmgr_vdev *vdev,
 		       struct sk_buff *skb);
 int dp_wrap_tx_process(struct net_device **dev, struct wlan_objmgr_vdev *vdev,
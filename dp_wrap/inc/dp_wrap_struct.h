@@ -21,12 +21,18 @@
 #if ATH_SUPPORT_WRAP
 
 #include <wbuf.h>
+#include <linux/jhash.h>
 
-#define	WRAP_DEV_HASHSIZE	32	/*dev hash table size*/
+#define	WRAP_DEV_HASHSIZE	64	/*dev hash table size, power of 2*/
 
-/*device table simple hash function*/
+/*
+ * device table hash function, over the full mac address: proxy MACs
+ * derived from one OUI or locally administered ranges frequently share
+ * their last byte
+ */
 #define	WRAP_DEV_HASH(addr)   \
-	(((const u_int8_t *)(addr))[QDF_MAC_ADDR_SIZE - 1] % WRAP_DEV_HASHSIZE)
+	(jhash((const u_int8_t *)(addr), QDF_MAC_ADDR_SIZE, 0) & \
+	 (WRAP_DEV_HASHSIZE - 1))
 
 #define qwrap_err(params...) QDF_TRACE_ERROR(QDF_MODULE_ID_WRAP, ## params)
 #define qwrap_warn(params...) QDF_TRACE_WARN(QDF_MODULE_ID_WRAP, ## params)
@@ -50,6 +56,10 @@ typedef struct dp_wrap_devt {
 	TAILQ_HEAD(, dp_wrap_vdev)	wdt_dev_vma;	/*head for device list*/
 	ATH_LIST_HEAD(, dp_wrap_vdev)	wdt_hash_vma[WRAP_DEV_HASHSIZE];
 					/*head for device hash*/
+	u_int16_t			wdt_hash_cnt[WRAP_DEV_HASHSIZE];
+					/*oma hash bucket occupancy*/
+	u_int16_t			wdt_hash_vma_cnt[WRAP_DEV_HASHSIZE];
+					/*vma hash bucket occupancy*/
 } dp_wrap_devt_t;
 
 /*wrap pdev struct*/
@@ -129,9 +129,11 @@ int dp_wrap_dev_add(struct wlan_objmgr_vdev *vdev)
 	OS_RWLOCK_WRITE_LOCK_BH(&wdt->wdt_lock, &lock_state);
 	LIST_INSERT_HEAD(&wdt->wdt_hash[hash], wrap_vdev, wrap_dev_hash);
 	TAILQ_INSERT_TAIL(&wdt->wdt_dev, wrap_vdev, wrap_dev_list);
+	wdt->wdt_hash_cnt[hash]++;
 	LIST_INSERT_HEAD(&wdt->wdt_hash_vma[hash_vma], wrap_vdev,
 			 wrap_dev_hash_vma);
 	TAILQ_INSERT_TAIL(&wdt->wdt_dev_vma, wrap_vdev, wrap_dev_list_vma);
+	wdt->wdt_hash_vma_cnt[hash_vma]++;
 	OS_RWLOCK_WRITE_UNLOCK_BH(&wdt->wdt_lock, &lock_state);
 	qwrap_info("Added vdev:%d to the list mat. pdev_id:%d",
 		   vdev->vdev_objmgr.vdev_id,
@@ -176,6 +178,7 @@ void dp_wrap_dev_remove(struct wlan_objmgr_vdev *vdev)
 			(struct qdf_mac_addr *)wrap_vdev->wrap_dev_oma)) {
 			LIST_REMOVE(wvdev, wrap_dev_hash);
 			TAILQ_REMOVE(&wdt->wdt_dev, wvdev, wrap_dev_list);
+			wdt->wdt_hash_cnt[hash]--;
 			OS_RWLOCK_WRITE_UNLOCK_BH(&wdt->wdt_lock, &lock_state);
 			qwrap_info("Removed vdev:%d from OMA list. pdev_id:%d",
 				   vdev->vdev_objmgr.vdev_id,
@@ -225,6 +228,7 @@ void dp_wrap_dev_remove_vma(struct wlan_objmgr_vdev *vdev)
 			LIST_REMOVE(wvdev, wrap_dev_hash_vma);
 			TAILQ_REMOVE(&wdt->wdt_dev_vma, wvdev,
 				     wrap_dev_list_vma);
+			wdt->wdt_hash_vma_cnt[hash]--;
 			OS_RWLOCK_WRITE_UNLOCK_BH(&wdt->wdt_lock, &lock_state);
 			qwrap_info("Removed vdev:%d from vma list. pdev_id:%d",
 				   vdev->vdev_objmgr.vdev_id,
@@ -236,6 +240,55 @@ void dp_wrap_dev_remove_vma(struct wlan_objmgr_vdev *vdev)
 	OS_RWLOCK_WRITE_UNLOCK_BH(&wdt->wdt_lock, &lock_state);
 }
 
+/**
+ * @brief Print OMA and VMA device hash occupancy, for tuning
+ * WRAP_DEV_HASHSIZE and checking the spread of proxy MACs.
+ *
+ * @param pdev objmgr Pointer.
+ *
+ * @return void
+ */
+void dp_wrap_devt_hash_stats(struct wlan_objmgr_pdev *pdev)
+{
+	struct dp_wrap_pdev *wrap_pdev;
+	struct dp_wrap_devt *wdt;
+	rwlock_state_t lock_state;
+	int i, used = 0, used_vma = 0, max = 0, max_vma = 0;
+	int total = 0, total_vma = 0;
+
+	wrap_pdev = dp_wrap_get_pdev_handle(pdev);
+	if (!wrap_pdev) {
+		qwrap_err(" wrap_pdev is NULL");
+		return;
+	}
+	wdt = &wrap_pdev->wp_devt;
+
+	OS_RWLOCK_READ_LOCK(&wdt->wdt_lock, &lock_state);
+	for (i = 0; i < WRAP_DEV_HASHSIZE; i++) {
+		if (wdt->wdt_hash_cnt[i]) {
+			used++;
+			total += wdt->wdt_hash_cnt[i];
+			max = QDF_MAX(max, wdt->wdt_hash_cnt[i]);
+		}
+		if (wdt->wdt_hash_vma_cnt[i]) {
+			used_vma++;
+			total_vma += wdt->wdt_hash_vma_cnt[i];
+			max_vma = QDF_MAX(max_vma, wdt->wdt_hash_vma_cnt[i]);
+		}
+		if (wdt->wdt_hash_cnt[i] > 1 || wdt->wdt_hash_vma_cnt[i] > 1)
+			qwrap_info("bucket %d: oma %u vma %u", i,
+				   wdt->wdt_hash_cnt[i],
+				   wdt->wdt_hash_vma_cnt[i]);
+	}
+	OS_RWLOCK_READ_UNLOCK(&wdt->wdt_lock, &lock_state);
+
+	qwrap_info("oma: %d entries in %d/%d buckets, max chain %d",
+		   total, used, WRAP_DEV_HASHSIZE, max);
+	qwrap_info("vma: %d entries in %d/%d buckets, max chain %d",
+		   total_vma, used_vma, WRAP_DEV_HASHSIZE, max_vma);
+}
+qdf_export_symbol(dp_wrap_devt_hash_stats);
+
 /**
  * @brief WRAP device table attach
  *
@@ -18,6 +18,21 @@
 #define __DP_EXTAP_MITBL_H_
 
 #include "qdf_net_types.h"
+#include <qdf_atomic.h>
+
+/*
+ * mi table backend, exactly one must be 1. The tree is used unless the
+ * build selects the array or the aging hash.
+ */
+#ifndef MI_TABLE_AS_ARRAY
+#define MI_TABLE_AS_ARRAY	0
+#endif
+#ifndef MI_TABLE_AS_HASH
+#define MI_TABLE_AS_HASH	0
+#endif
+#ifndef MI_TABLE_AS_TREE
+#define MI_TABLE_AS_TREE	(!MI_TABLE_AS_ARRAY && !MI_TABLE_AS_HASH)
+#endif
 
 #define ATH_MITBL_NONE 0x0000
 #define ATH_MITBL_IPV4 0x0001
@@ -33,6 +48,16 @@ typedef struct mi_node { /* MAC - IP Node */
 	ip_ver,
 	ip[16];	/* v4 or v6 ip addr */
 } mi_node_t;
+#elif MI_TABLE_AS_HASH
+typedef struct mi_node { /* MAC - IP Node */
+	struct mi_node *next;
+	unsigned long last_seen;	/* ticks, for aging */
+	qdf_atomic_t referenced;	/* set by lookups, for aging */
+	u_int8_t h_dest[QDF_NET_ETH_LEN],
+	len,
+	ip_ver,
+	ip[16];	/* v4 or v6 ip addr */
+} mi_node_t;
 #else
 #define mi_node_is_free(n)	((n)->ip_ver == ATH_MITBL_NONE)
 #define mi_node_free(n)	do { (n)->ip_ver = ATH_MITBL_NONE; } while (0)
@@ -55,4 +80,24 @@ u_int8_t *mi_tbl_lkup(mi_node_t *root, u_int8_t *ip, int ipver);
 void mi_tbl_del(mi_node_t **root, u_int8_t *ip, int ipver);
 void mi_tbl_dump(void *arg);
 void mi_tbl_purge(mi_node_t **root);
+
+#if MI_TABLE_AS_HASH
+int mi_tbl_init(mi_node_t **root, void (*age_fn)(void *), void *age_ctx);
+void mi_tbl_deinit(mi_node_t **root);
+void mi_tbl_age(mi_node_t *root);
+#else
+static inline int mi_tbl_init(mi_node_t **root, void (*age_fn)(void *),
+			      void *age_ctx)
+{
+	return 0;
+}
+
+static inline void mi_tbl_deinit(mi_node_t **root)
+{
+}
+
+static inline void mi_tbl_age(mi_node_t *root)
+{
+}
+#endif /* MI_TABLE_AS_HASH */
 #endif /* __DP_EXTAP_MITBL_H_ */
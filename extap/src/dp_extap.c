@@ -541,6 +541,22 @@ void dp_extap_mitbl_dump(dp_pdev_extap_t *extap)
 	OS_RWLOCK_READ_UNLOCK(&extap->mi_lock, &lock_state);
 }
 
+/**
+ * dp_extap_mitbl_age() - mi table aging timer handler
+ * @arg: extap pdev handle
+ *
+ * Return: void
+ */
+static void dp_extap_mitbl_age(void *arg)
+{
+	dp_pdev_extap_t *extap = (dp_pdev_extap_t *)arg;
+	rwlock_state_t lock_state;
+
+	OS_RWLOCK_WRITE_LOCK(&extap->mi_lock, &lock_state);
+	mi_tbl_age(extap->miroot);
+	OS_RWLOCK_WRITE_UNLOCK(&extap->mi_lock, &lock_state);
+}
+
 void dp_extap_mitbl_purge(dp_pdev_extap_t *extap)
 {
 	rwlock_state_t lock_state;
@@ -649,6 +665,12 @@ int dp_extap_attach(struct wlan_objmgr_pdev *pdev)
 	}
 
 	OS_RWLOCK_INIT(&extap_pdev->mi_lock);
+	ret = mi_tbl_init(&extap_pdev->miroot, dp_extap_mitbl_age, extap_pdev);
+	if (ret) {
+		extap_err("mi table alloc failed");
+		OS_RWLOCK_DESTROY(&extap_pdev->mi_lock);
+	}
+
 	return ret;
 }
 qdf_export_symbol(dp_extap_attach);
@@ -670,6 +692,7 @@ int dp_extap_detach(struct wlan_objmgr_pdev *pdev)
 		extap_debug(" extap_pdev is NULL");
 		return -EINVAL;
 	}
+	mi_tbl_deinit(&extap_pdev->miroot);
 	OS_RWLOCK_DESTROY(&extap_pdev->mi_lock);
 	return ret;
 }
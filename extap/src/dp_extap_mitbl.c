@@ -14,9 +14,6 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
-#define MI_TABLE_AS_ARRAY	0
-#define MI_TABLE_AS_TREE	1
-
 #include <osdep.h>
 #include <if_llc.h>
 #include <if_upperproto.h>
@@ -26,8 +23,8 @@
 #include <dp_extap_mitbl.h>
 #include <dp_extap.h>
 
-#if MI_TABLE_AS_TREE == MI_TABLE_AS_ARRAY
-#	error "Define either one of MI_TABLE_AS_ARRAY or MI_TABLE_AS_TREE"
+#if (MI_TABLE_AS_ARRAY + MI_TABLE_AS_TREE + MI_TABLE_AS_HASH) != 1
+#	error "Define exactly one of MI_TABLE_AS_ARRAY, MI_TABLE_AS_TREE or MI_TABLE_AS_HASH"
 #endif
 static inline void mi_node_print(mi_node_t *);
 
@@ -624,3 +621,389 @@ mi_tbl_dump(void *arg)
 	}
 }
 #endif /* MI_TABLE_AS_TREE */
+
+
+#if MI_TABLE_AS_HASH
+#include <qdf_time.h>
+#include <qdf_mem.h>
+#include <qdf_util.h>
+#include <qdf_timer.h>
+
+/*
+ * Hash table keyed on the ip address, backed by a fixed node pool so
+ * that memory stays bounded. One table is allocated per extap instance
+ * by mi_tbl_init() and the instance's miroot points at its head node,
+ * so the table shares the instance's mi_lock.
+ *
+ * Lookups run under the read side of mi_lock and only set the node's
+ * referenced flag; last_seen is updated under the write side, when the
+ * entry is learnt or when an aging pass finds it referenced. Entries
+ * neither looked up nor re-learnt for MI_TBL_HASH_AGE_MS are reclaimed by
+ * a sweep of the whole table every MI_TBL_HASH_SWEEP_MS, run from the
+ * instance's timer under the write side of mi_lock. When the pool is
+ * exhausted a clock hand over the pool evicts the first unreferenced
+ * entry. Nodes are
+ * only freed with the table, so a mac pointer handed out by mi_tbl_lkup()
+ * stays dereferencable after mi_lock is dropped.
+ */
+#define MI_TBL_HASH_SIZE		256
+#define MI_TBL_HASH_MAX_ENTRIES		1024
+#define MI_TBL_HASH_AGE_MS		300000
+#define MI_TBL_HASH_SWEEP_MS		(MI_TBL_HASH_AGE_MS / 4)
+
+/**
+ * struct mi_hash_tbl - per instance mi hash table
+ * @head: handle stored in the instance's miroot, not an entry
+ * @bucket: hash chains
+ * @free_list: nodes returned to the pool
+ * @pool_used: pool nodes handed out at least once
+ * @clock_hand: next pool node considered for eviction
+ * @age_timer: periodic aging sweep, its handler takes mi_lock
+ * @pool: entry nodes
+ */
+struct mi_hash_tbl {
+	mi_node_t head;
+	mi_node_t *bucket[MI_TBL_HASH_SIZE];
+	mi_node_t *free_list;
+	int pool_used;
+	int clock_hand;
+	qdf_timer_t age_timer;
+	mi_node_t pool[MI_TBL_HASH_MAX_ENTRIES];
+};
+
+static inline struct mi_hash_tbl *mi_hash_tbl_get(mi_node_t *root)
+{
+	if (!root)
+		return NULL;
+
+	return qdf_container_of(root, struct mi_hash_tbl, head);
+}
+
+static inline uint32_t mi_hash(u_int8_t *ip, int ipver)
+{
+	uint32_t hash = ipver;
+	uint32_t word;
+	int i, len = mi_ip_len(ipver);
+
+	for (i = 0; i < len; i += 4) {
+		OS_MEMCPY(&word, ip + i, sizeof(word));
+		hash = (hash ^ word) * 0x9e3779b1;
+	}
+
+	return (hash ^ (hash >> 16)) & (MI_TBL_HASH_SIZE - 1);
+}
+
+static inline bool mi_node_is_expired(mi_node_t *n, unsigned long now)
+{
+	return qdf_system_time_after(now, n->last_seen +
+			qdf_system_msecs_to_ticks(MI_TBL_HASH_AGE_MS));
+}
+
+/**
+ * mi_node_test_and_clear_ref() - consume the referenced flag of a node
+ * @n: node
+ * @now: current ticks
+ *
+ * Must be called with the write side of mi_lock held.
+ *
+ * Return: true if the node was looked up since the last call
+ */
+static inline bool mi_node_test_and_clear_ref(mi_node_t *n, unsigned long now)
+{
+	if (!qdf_atomic_read(&n->referenced))
+		return false;
+
+	qdf_atomic_set(&n->referenced, 0);
+	n->last_seen = now;
+
+	return true;
+}
+
+static inline void mi_node_put(struct mi_hash_tbl *tbl, mi_node_t *n)
+{
+	n->ip_ver = ATH_MITBL_NONE;
+	n->len = ATH_MITBL_NONE;
+	qdf_atomic_set(&n->referenced, 0);
+	n->next = tbl->free_list;
+	tbl->free_list = n;
+}
+
+static mi_node_t *mi_hash_find(struct mi_hash_tbl *tbl, u_int8_t *ip,
+			       int ipver, mi_node_t ***pprev)
+{
+	mi_node_t **prev = &tbl->bucket[mi_hash(ip, ipver)];
+	mi_node_t *n;
+	int len = mi_ip_len(ipver);
+
+	for (n = *prev; n; prev = &n->next, n = n->next) {
+		if (n->ip_ver == ipver && !OS_MEMCMP(ip, n->ip, len)) {
+			if (pprev)
+				*pprev = prev;
+			return n;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * mi_hash_sweep() - reclaim expired entries from a range of buckets
+ * @tbl: mi hash table
+ * @start: first bucket
+ * @num: number of buckets to sweep
+ *
+ * Return: number of entries reclaimed
+ */
+static int mi_hash_sweep(struct mi_hash_tbl *tbl, int start, int num)
+{
+	unsigned long now = qdf_system_ticks();
+	mi_node_t **prev, *n;
+	int i, reclaimed = 0;
+
+	for (i = 0; i < num; i++) {
+		prev = &tbl->bucket[(start + i) & (MI_TBL_HASH_SIZE - 1)];
+		while ((n = *prev)) {
+			if (!mi_node_test_and_clear_ref(n, now) &&
+			    mi_node_is_expired(n, now)) {
+				*prev = n->next;
+				extap_debug("aging out " eamstr "\n",
+					    eamac(n->h_dest));
+				mi_node_put(tbl, n);
+				reclaimed++;
+				continue;
+			}
+			prev = &n->next;
+		}
+	}
+
+	return reclaimed;
+}
+
+/**
+ * mi_hash_evict() - evict one entry from a full pool
+ * @tbl: mi hash table
+ *
+ * Second chance over the pool: referenced entries are refreshed and
+ * skipped, the first unreferenced entry is evicted. Each node is visited
+ * at most twice.
+ *
+ * Return: void
+ */
+static void mi_hash_evict(struct mi_hash_tbl *tbl)
+{
+	unsigned long now = qdf_system_ticks();
+	mi_node_t *n, **prev;
+	int i;
+
+	for (i = 0; i < 2 * MI_TBL_HASH_MAX_ENTRIES; i++) {
+		n = &tbl->pool[tbl->clock_hand];
+		tbl->clock_hand = (tbl->clock_hand + 1) &
+				  (MI_TBL_HASH_MAX_ENTRIES - 1);
+
+		if (n->ip_ver == ATH_MITBL_NONE ||
+		    mi_node_test_and_clear_ref(n, now))
+			continue;
+
+		if (mi_hash_find(tbl, n->ip, n->ip_ver, &prev) != n)
+			continue;
+
+		*prev = n->next;
+		extap_debug("evicting " eamstr "\n", eamac(n->h_dest));
+		mi_node_put(tbl, n);
+		return;
+	}
+}
+
+static mi_node_t *mi_node_get(struct mi_hash_tbl *tbl)
+{
+	mi_node_t *n;
+
+	if (tbl->pool_used < MI_TBL_HASH_MAX_ENTRIES)
+		return &tbl->pool[tbl->pool_used++];
+
+	if (!tbl->free_list)
+		mi_hash_evict(tbl);
+
+	n = tbl->free_list;
+	if (n)
+		tbl->free_list = n->next;
+
+	return n;
+}
+
+mi_node_t *mi_tbl_add(mi_node_t **root, u_int8_t *ip,
+		      u_int8_t *mac, int ipver)
+{
+	struct mi_hash_tbl *tbl = mi_hash_tbl_get(*root);
+	int len = mi_ip_len(ipver);
+	uint32_t hash;
+	mi_node_t *a;
+
+	if (!tbl)
+		return NULL;
+
+	a = mi_hash_find(tbl, ip, ipver, NULL);
+	if (a) {
+		extap_debug("overwriting " eamstr " for " eaistr "\n",
+			    eamac(mac), eaip(ip));
+		OS_MEMCPY(a->h_dest, mac, ETH_ALEN);
+		a->last_seen = qdf_system_ticks();
+
+		return a;
+	}
+
+	a = mi_node_get(tbl);
+	if (!a) {
+		extap_debug("cant save " eamstr " for " eaistr "\n",
+			    eamac(mac), eaip(ip));
+		return NULL;
+	}
+
+	OS_MEMCPY(a->h_dest, mac, ETH_ALEN);
+	OS_MEMCPY(a->ip, ip, len);
+	a->ip_ver = ipver;
+	a->len = len;
+	a->last_seen = qdf_system_ticks();
+	qdf_atomic_set(&a->referenced, 0);
+
+	hash = mi_hash(ip, ipver);
+	a->next = tbl->bucket[hash];
+	tbl->bucket[hash] = a;
+	extap_debug("saving " eamstr " for " eaistr "\n",
+		    eamac(mac), eaip(ip));
+
+	return a;
+}
+
+	u_int8_t *
+mi_tbl_lkup(mi_node_t *root, u_int8_t *ip, int ipver)
+{
+	struct mi_hash_tbl *tbl = mi_hash_tbl_get(root);
+	mi_node_t *a;
+
+	if (!tbl)
+		return NULL;
+
+	a = mi_hash_find(tbl, ip, ipver, NULL);
+	if (a) {
+		if (!qdf_atomic_read(&a->referenced))
+			qdf_atomic_set(&a->referenced, 1);
+		return a->h_dest;
+	}
+
+	extap_debug("lkup failed for " eaistr "\n", eaip(ip));
+
+	return NULL;
+}
+
+void mi_tbl_del(mi_node_t **root, u_int8_t *ip, int ipver)
+{
+	struct mi_hash_tbl *tbl = mi_hash_tbl_get(*root);
+	mi_node_t **prev;
+	mi_node_t *a;
+
+	if (!tbl)
+		return;
+
+	a = mi_hash_find(tbl, ip, ipver, &prev);
+	if (a) {
+		*prev = a->next;
+		extap_debug("deleting " eamstr " for " eaistr "\n",
+			    eamac(a->h_dest), eaip(ip));
+		mi_node_put(tbl, a);
+		return;
+	}
+	extap_debug("delete failed for " eaistr "\n", eaip(ip));
+}
+
+void mi_tbl_dump(void *arg)
+{
+	struct mi_hash_tbl *tbl = mi_hash_tbl_get((mi_node_t *)arg);
+	mi_node_t *n;
+	int i;
+
+	if (!tbl)
+		return;
+
+	qdf_info("%s: hash", __func__);
+	for (i = 0; i < MI_TBL_HASH_SIZE; i++) {
+		for (n = tbl->bucket[i]; n; n = n->next)
+			mi_node_print(n);
+	}
+}
+
+void mi_tbl_purge(mi_node_t **root)
+{
+	struct mi_hash_tbl *tbl = mi_hash_tbl_get(*root);
+
+	if (!tbl)
+		return;
+
+	OS_MEMSET(tbl->bucket, 0, sizeof(tbl->bucket));
+	OS_MEMSET(tbl->pool, 0, sizeof(tbl->pool));
+	tbl->free_list = NULL;
+	tbl->pool_used = 0;
+	tbl->clock_hand = 0;
+}
+
+/**
+ * mi_tbl_age() - reclaim expired entries and re-arm the aging timer
+ * @root: table handle
+ *
+ * Called from the @age_fn given to mi_tbl_init() with the write side of
+ * mi_lock held.
+ *
+ * Return: void
+ */
+void mi_tbl_age(mi_node_t *root)
+{
+	struct mi_hash_tbl *tbl = mi_hash_tbl_get(root);
+	int reclaimed;
+
+	if (!tbl)
+		return;
+
+	reclaimed = mi_hash_sweep(tbl, 0, MI_TBL_HASH_SIZE);
+	if (reclaimed)
+		extap_debug("aged out %d entries\n", reclaimed);
+
+	qdf_timer_mod(&tbl->age_timer, MI_TBL_HASH_SWEEP_MS);
+}
+
+/**
+ * mi_tbl_init() - allocate the table of one extap instance
+ * @root: instance handle to set
+ * @age_fn: timer handler, takes mi_lock and calls mi_tbl_age()
+ * @age_ctx: context passed to @age_fn
+ *
+ * Return: 0 on success, -ENOMEM on failure
+ */
+int mi_tbl_init(mi_node_t **root, void (*age_fn)(void *), void *age_ctx)
+{
+	struct mi_hash_tbl *tbl;
+
+	tbl = qdf_mem_malloc(sizeof(*tbl));
+	if (!tbl)
+		return -ENOMEM;
+
+	qdf_timer_init(NULL, &tbl->age_timer, age_fn, age_ctx,
+		       QDF_TIMER_TYPE_SW);
+	*root = &tbl->head;
+	qdf_timer_mod(&tbl->age_timer, MI_TBL_HASH_SWEEP_MS);
+
+	return 0;
+}
+
+void mi_tbl_deinit(mi_node_t **root)
+{
+	struct mi_hash_tbl *tbl = mi_hash_tbl_get(*root);
+
+	if (!tbl)
+		return;
+
+	qdf_timer_sync_cancel(&tbl->age_timer);
+	qdf_timer_free(&tbl->age_timer);
+	*root = NULL;
+	qdf_mem_free(tbl);
+}
+#endif /* MI_TABLE_AS_HASH */
@@ -16,6 +16,8 @@
 
 #ifndef _DP_MON_UTILS_H_
 #define _DP_MON_UTILS_H_
+#include <qdf_status.h>
+
 /* fwd declartion */
 struct ol_ath_softc_net80211;
 
@@ -51,5 +53,30 @@ void wlan_lite_mon_tx_subscribe(struct ol_ath_softc_net80211 *scn);
  * Return: void
  */
 void wlan_lite_mon_tx_unsubscribe(struct ol_ath_softc_net80211 *scn);
+
+/**
+ * wlan_lite_mon_set_batch_params - set lite mon batched delivery params
+ * @scn: scn hdl
+ * @thresh: frames queued before a batch is delivered, 1 disables batching
+ * @timeout_ms: max time a frame waits for its batch to fill
+ *
+ * The params take effect at once for the rx and tx batches of @scn and
+ * are used for every lite mon subscription made afterwards.
+ *
+ * Return: QDF_STATUS_SUCCESS on success, QDF_STATUS_E_INVAL if a param
+ * is out of range
+ */
+QDF_STATUS
+wlan_lite_mon_set_batch_params(struct ol_ath_softc_net80211 *scn,
+			       uint32_t thresh, uint32_t timeout_ms);
+
+/**
+ * wlan_lite_mon_get_batch_params - get lite mon batched delivery params
+ * @thresh: frames queued before a batch is delivered
+ * @timeout_ms: max time a frame waits for its batch to fill
+ *
+ * Return: void
+ */
+void wlan_lite_mon_get_batch_params(uint32_t *thresh, uint32_t *timeout_ms);
 #endif
 #endif /* _DP_MON_UTILS_H_ */
@@ -20,7 +20,8 @@
 
 #define IFNAME_SIZE 16
 
-void monitor_osif_process_rx_mpdu(osif_dev *osifp, qdf_nbuf_t mpdu_ind)
+static inline
+void monitor_osif_prep_rx_mpdu(osif_dev *osifp, qdf_nbuf_t mpdu_ind)
 {
 	skb_reset_mac_header(mpdu_ind);
 	mpdu_ind->dev       = osifp->netdev;
@@ -28,19 +29,79 @@ void monitor_osif_process_rx_mpdu(osif_dev *osifp, qdf_nbuf_t mpdu_ind)
 	mpdu_ind->ip_summed = CHECKSUM_UNNECESSARY;
 	mpdu_ind->protocol  = qdf_cpu_to_le16(ETH_P_802_2);
 	nbuf_debug_del_record(mpdu_ind);
-	netif_rx(mpdu_ind);
 }
 
-void monitor_osif_deliver_tx_capture_data(osif_dev *osifp, struct sk_buff *skb)
+static inline
+void monitor_osif_prep_tx_capture_data(osif_dev *osifp, struct sk_buff *skb)
 {
 	skb->dev = osifp->netdev;
 	skb->pkt_type = PACKET_USER;
 	skb->ip_summed = CHECKSUM_UNNECESSARY;
 	skb->protocol = eth_type_trans(skb, osifp->netdev);
 	nbuf_debug_del_record(skb);
+}
+
+void monitor_osif_process_rx_mpdu(osif_dev *osifp, qdf_nbuf_t mpdu_ind)
+{
+	monitor_osif_prep_rx_mpdu(osifp, mpdu_ind);
+	netif_rx(mpdu_ind);
+}
+
+void monitor_osif_deliver_tx_capture_data(osif_dev *osifp, struct sk_buff *skb)
+{
+	monitor_osif_prep_tx_capture_data(osifp, skb);
 	netif_rx(skb);
 }
 
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 19, 0))
+/*
+ * Hand a whole batch to the stack in one call, this amortizes the per
+ * packet softirq and protocol demux cost of netif_rx.
+ */
+static void monitor_osif_deliver_list(osif_dev *osifp, qdf_nbuf_queue_t *q,
+				      bool is_tx)
+{
+	qdf_nbuf_t nbuf;
+	LIST_HEAD(rx_list);
+
+	while ((nbuf = qdf_nbuf_queue_remove(q))) {
+		if (is_tx)
+			monitor_osif_prep_tx_capture_data(osifp, nbuf);
+		else
+			monitor_osif_prep_rx_mpdu(osifp, nbuf);
+		list_add_tail(&nbuf->list, &rx_list);
+	}
+
+	/* callers may run from workqueue context */
+	local_bh_disable();
+	netif_receive_skb_list(&rx_list);
+	local_bh_enable();
+}
+#else
+static void monitor_osif_deliver_list(osif_dev *osifp, qdf_nbuf_queue_t *q,
+				      bool is_tx)
+{
+	qdf_nbuf_t nbuf;
+
+	while ((nbuf = qdf_nbuf_queue_remove(q))) {
+		if (is_tx)
+			monitor_osif_deliver_tx_capture_data(osifp, nbuf);
+		else
+			monitor_osif_process_rx_mpdu(osifp, nbuf);
+	}
+}
+#endif
+
+void monitor_osif_process_rx_mpdu_list(osif_dev *osifp, qdf_nbuf_queue_t *q)
+{
+	monitor_osif_deliver_list(osifp, q, false);
+}
+
+void monitor_osif_deliver_tx_capture_list(osif_dev *osifp, qdf_nbuf_queue_t *q)
+{
+	monitor_osif_deliver_list(osifp, q, true);
+}
+
 #ifdef QCA_UNDECODED_METADATA_SUPPORT
 void monitor_osif_deliver_rx_capture_undecoded_metadata(osif_dev *osifp,
 							struct sk_buff *skb)
@@ -17,38 +17,322 @@
 #include <ol_if_athvar.h>
 #include <cdp_txrx_ctrl.h>
 #include <dp_mon.h>
+#include <qdf_timer.h>
+#include <linux/netdevice.h>
+#include <dp_mon_utils.h>
 
 #ifdef QCA_SUPPORT_LITE_MONITOR
 
 void monitor_osif_process_rx_mpdu(osif_dev *osifp, qdf_nbuf_t mpdu_ind);
 void monitor_osif_deliver_tx_capture_data(osif_dev *osifp, struct sk_buff *skb);
+void monitor_osif_process_rx_mpdu_list(osif_dev *osifp, qdf_nbuf_queue_t *q);
+void monitor_osif_deliver_tx_capture_list(osif_dev *osifp, qdf_nbuf_queue_t *q);
+
+/* frames accumulated before a batch is handed to the monitor vap */
+#ifndef LITE_MON_BATCH_THRESH
+#define LITE_MON_BATCH_THRESH 32
+#endif
+
+/* max time a frame waits for its batch to fill */
+#ifndef LITE_MON_BATCH_TIMEOUT_MS
+#define LITE_MON_BATCH_TIMEOUT_MS 2
+#endif
+
+/* upper bounds accepted from wlan_lite_mon_set_batch_params */
+#define LITE_MON_BATCH_THRESH_MAX 256
+#define LITE_MON_BATCH_TIMEOUT_MS_MAX 100
+
+/* poll interval and count while waiting for handlers to leave a batch */
+#define LITE_MON_BATCH_QUIESCE_WAIT_MS 10
+#define LITE_MON_BATCH_QUIESCE_WAIT_CNT 100
+
+/* batch params applied to subscriptions made from now on */
+static uint32_t lite_mon_batch_thresh = LITE_MON_BATCH_THRESH;
+static uint32_t lite_mon_batch_timeout_ms = LITE_MON_BATCH_TIMEOUT_MS;
 
 /**
- * wlan_lite_mon_rx_process - rx lite mon wdi event handler
- * @pdev_hdl: dp pdev hdl
- * @event: WDI_EVENT_LITE_MON_RX
- * @data: nbuf
- * @peer_id: peer id
- * @status: status
+ * struct wlan_lite_mon_batch_stats - lite mon batched delivery stats
+ * @batches: number of batches handed to the stack
+ * @frames: number of frames handed to the stack
+ * @drops: number of frames freed for want of a monitor vap
+ */
+struct wlan_lite_mon_batch_stats {
+	uint64_t batches;
+	uint64_t frames;
+	uint64_t drops;
+};
+
+/**
+ * struct wlan_lite_mon_batch - lite mon frames pending delivery to the
+ * monitor vap of a radio
+ * @pdev_obj: pdev object
+ * @lock: protects @q, @thresh, @timeout_ms and @stats
+ * @q: frames pending delivery
+ * @timer: flushes @q when @thresh is not reached within @timeout_ms
+ * @thresh: queue length that triggers a flush, 1 disables batching
+ * @timeout_ms: flush timeout
+ * @is_tx: batch carries tx capture frames
+ * @in_flight: wdi handlers currently running on this batch
+ * @stats: delivery stats
+ *
+ * The monitor vap is looked up when the batch is flushed rather than
+ * when a frame is queued, so a vap going away while frames are pending
+ * results in the frames being dropped instead of a stale reference.
+ */
+struct wlan_lite_mon_batch {
+	struct wlan_objmgr_pdev *pdev_obj;
+	qdf_spinlock_t lock;
+	qdf_nbuf_queue_t q;
+	qdf_timer_t timer;
+	uint32_t thresh;
+	uint32_t timeout_ms;
+	bool is_tx;
+	qdf_atomic_t in_flight;
+	struct wlan_lite_mon_batch_stats stats;
+};
+
+/**
+ * wlan_lite_mon_batch_flush - deliver pending frames to the monitor vap
+ * @batch: lite mon batch
  *
  * Return: void
  */
-static void wlan_lite_mon_rx_process(void *pdev_hdl, enum WDI_EVENT event,
-				     void *data, uint16_t peer_id,
-				     uint32_t status)
+static void wlan_lite_mon_batch_flush(struct wlan_lite_mon_batch *batch)
 {
-	/* handle rx mpdus */
-	qdf_nbuf_t skb = (qdf_nbuf_t)data;
-	struct wlan_objmgr_pdev *pdev_obj =
-			(struct wlan_objmgr_pdev *)pdev_hdl;
-	struct ieee80211com *ic = wlan_pdev_get_mlme_ext_obj(pdev_obj);
+	struct ieee80211com *ic;
 	struct ieee80211vap *vap = NULL;
+	qdf_nbuf_queue_t q;
+	uint32_t len;
 
-	if (!skb)
+	qdf_spin_lock_bh(&batch->lock);
+	len = qdf_nbuf_queue_len(&batch->q);
+	if (!len) {
+		qdf_spin_unlock_bh(&batch->lock);
+		return;
+	}
+	qdf_nbuf_queue_init(&q);
+	qdf_nbuf_queue_append(&q, &batch->q);
+	qdf_nbuf_queue_init(&batch->q);
+	qdf_spin_unlock_bh(&batch->lock);
+
+	ic = wlan_pdev_get_mlme_ext_obj(batch->pdev_obj);
+	if (ic)
+		vap = ic->ic_mon_vap;
+
+	if (!vap) {
+		qdf_nbuf_queue_free(&q);
+		qdf_spin_lock_bh(&batch->lock);
+		batch->stats.drops += len;
+		qdf_spin_unlock_bh(&batch->lock);
+		dp_mon_debug("No mon vap to dump %u frames", len);
+		return;
+	}
+
+	if (batch->is_tx)
+		monitor_osif_deliver_tx_capture_list((osif_dev *)vap->iv_ifp,
+						     &q);
+	else
+		monitor_osif_process_rx_mpdu_list((osif_dev *)vap->iv_ifp, &q);
+
+	qdf_spin_lock_bh(&batch->lock);
+	batch->stats.batches++;
+	batch->stats.frames += len;
+	qdf_spin_unlock_bh(&batch->lock);
+}
+
+/**
+ * wlan_lite_mon_batch_timer_handler - flush a batch which did not fill
+ * within its timeout
+ * @arg: lite mon batch
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_batch_timer_handler(void *arg)
+{
+	wlan_lite_mon_batch_flush((struct wlan_lite_mon_batch *)arg);
+}
+
+/**
+ * wlan_lite_mon_batch_add - queue a frame for batched delivery
+ * @batch: lite mon batch
+ * @nbuf: frame
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_batch_add(struct wlan_lite_mon_batch *batch,
+				    qdf_nbuf_t nbuf)
+{
+	uint32_t len;
+	uint32_t thresh;
+
+	qdf_spin_lock_bh(&batch->lock);
+	qdf_nbuf_queue_add(&batch->q, nbuf);
+	len = qdf_nbuf_queue_len(&batch->q);
+	thresh = batch->thresh;
+	if (len == 1 && thresh > 1)
+		qdf_timer_mod(&batch->timer, batch->timeout_ms);
+	qdf_spin_unlock_bh(&batch->lock);
+
+	if (len >= thresh)
+		wlan_lite_mon_batch_flush(batch);
+}
+
+/**
+ * wlan_lite_mon_batch_drop - account a frame freed for want of a
+ * monitor vap
+ * @batch: lite mon batch, NULL for unbatched delivery
+ *
+ * Return: void
+ */
+static inline
+void wlan_lite_mon_batch_drop(struct wlan_lite_mon_batch *batch)
+{
+	if (!batch)
 		return;
 
+	qdf_spin_lock_bh(&batch->lock);
+	batch->stats.drops++;
+	qdf_spin_unlock_bh(&batch->lock);
+}
+
+/**
+ * wlan_lite_mon_batch_create - allocate a lite mon batch
+ * @pdev_obj: pdev object
+ * @is_tx: batch carries tx capture frames
+ *
+ * Return: batch on success, NULL on allocation failure
+ */
+static struct wlan_lite_mon_batch *
+wlan_lite_mon_batch_create(struct wlan_objmgr_pdev *pdev_obj, bool is_tx)
+{
+	struct wlan_lite_mon_batch *batch;
+
+	batch = qdf_mem_malloc(sizeof(*batch));
+	if (!batch) {
+		dp_mon_err("lite mon batch alloc fail, delivering unbatched");
+		return NULL;
+	}
+
+	batch->pdev_obj = pdev_obj;
+	batch->is_tx = is_tx;
+	batch->thresh = lite_mon_batch_thresh;
+	batch->timeout_ms = lite_mon_batch_timeout_ms;
+	qdf_atomic_init(&batch->in_flight);
+	qdf_nbuf_queue_init(&batch->q);
+	qdf_spinlock_create(&batch->lock);
+	qdf_timer_init(NULL, &batch->timer,
+		       wlan_lite_mon_batch_timer_handler,
+		       (void *)batch,
+		       QDF_TIMER_TYPE_WAKE_APPS);
+
+	return batch;
+}
+
+/**
+ * wlan_lite_mon_batch_quiesce - wait for wdi handlers to leave a batch
+ * @batch: lite mon batch
+ *
+ * Must be called once the wdi event feeding @batch is unsubscribed. The
+ * grace period covers a handler which has picked up @batch from the
+ * subscriber list but not yet marked itself in flight, the in flight
+ * count covers the rest of the handler.
+ *
+ * Return: true if no handler is left running on @batch
+ */
+static bool wlan_lite_mon_batch_quiesce(struct wlan_lite_mon_batch *batch)
+{
+	uint32_t wait_cnt = 0;
+
+	synchronize_net();
+
+	while (qdf_atomic_read(&batch->in_flight) &&
+	       wait_cnt < LITE_MON_BATCH_QUIESCE_WAIT_CNT) {
+		OS_SLEEP(LITE_MON_BATCH_QUIESCE_WAIT_MS * 1000);
+		wait_cnt++;
+	}
+
+	return !qdf_atomic_read(&batch->in_flight);
+}
+
+/**
+ * wlan_lite_mon_batch_destroy - flush pending frames and free a batch
+ * @batch: lite mon batch
+ *
+ * Must be called once the wdi event feeding @batch is unsubscribed. The
+ * batch is leaked rather than freed under a handler which fails to
+ * leave it.
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_batch_destroy(struct wlan_lite_mon_batch *batch)
+{
+	struct wlan_lite_mon_batch_stats *stats = &batch->stats;
+
+	if (!wlan_lite_mon_batch_quiesce(batch)) {
+		dp_mon_err("lite mon %s batch still in use by %d handlers",
+			   batch->is_tx ? "tx" : "rx",
+			   qdf_atomic_read(&batch->in_flight));
+		return;
+	}
+
+	qdf_timer_sync_cancel(&batch->timer);
+	wlan_lite_mon_batch_flush(batch);
+	qdf_timer_free(&batch->timer);
+
+	dp_mon_info("lite mon %s batches %llu frames %llu avg %llu drops %llu",
+		    batch->is_tx ? "tx" : "rx",
+		    stats->batches, stats->frames,
+		    stats->batches ?
+		    qdf_do_div(stats->frames, stats->batches) : 0,
+		    stats->drops);
+
+	qdf_spinlock_destroy(&batch->lock);
+	qdf_mem_free(batch);
+}
+
+/**
+ * wlan_lite_mon_batch_set_params - update the batching params of a batch
+ * @batch: lite mon batch
+ * @thresh: queue length that triggers a flush, 1 disables batching
+ * @timeout_ms: flush timeout
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_batch_set_params(struct wlan_lite_mon_batch *batch,
+					   uint32_t thresh,
+					   uint32_t timeout_ms)
+{
+	uint32_t len;
+
+	qdf_spin_lock_bh(&batch->lock);
+	batch->thresh = thresh;
+	batch->timeout_ms = timeout_ms;
+	len = qdf_nbuf_queue_len(&batch->q);
+	qdf_spin_unlock_bh(&batch->lock);
+
+	/* frames already queued are not held back by the new params */
+	if (len)
+		wlan_lite_mon_batch_flush(batch);
+}
+
+/**
+ * wlan_lite_mon_rx_deliver - deliver a lite mon rx mpdu to the monitor vap
+ * @pdev_obj: pdev object
+ * @batch: lite mon rx batch, NULL for unbatched delivery
+ * @skb: mpdu
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_rx_deliver(struct wlan_objmgr_pdev *pdev_obj,
+				     struct wlan_lite_mon_batch *batch,
+				     qdf_nbuf_t skb)
+{
+	struct ieee80211com *ic = wlan_pdev_get_mlme_ext_obj(pdev_obj);
+	struct ieee80211vap *vap;
+
 	if (!ic) {
 		qdf_nbuf_free(skb);
+		wlan_lite_mon_batch_drop(batch);
 		qdf_debug("ic is NULL");
 		return;
 	}
@@ -56,88 +340,192 @@ static void wlan_lite_mon_rx_process(void *pdev_hdl, enum WDI_EVENT event,
 	vap = ic->ic_mon_vap;
 	if (!vap) {
 		qdf_nbuf_free(skb);
+		wlan_lite_mon_batch_drop(batch);
 		qdf_debug("No mon vap to dump skb");
 		return;
 	}
 
-	monitor_osif_process_rx_mpdu((osif_dev *)vap->iv_ifp, skb);
+	if (batch)
+		wlan_lite_mon_batch_add(batch, skb);
+	else
+		monitor_osif_process_rx_mpdu((osif_dev *)vap->iv_ifp, skb);
 }
 
 /**
- * wlan_lite_mon_tx_process - tx lite mon wdi event handler
- * @pdev_hdl: dp pdev hdl
- * @event: WDI_EVENT_LITE_MON_TX
+ * wlan_lite_mon_rx_process - batched rx lite mon wdi event handler
+ * @ctx: lite mon rx batch
+ * @event: WDI_EVENT_LITE_MON_RX
  * @data: nbuf
  * @peer_id: peer id
  * @status: status
  *
  * Return: void
  */
-static void wlan_lite_mon_tx_process(void *pdev_hdl, enum WDI_EVENT event,
+static void wlan_lite_mon_rx_process(void *ctx, enum WDI_EVENT event,
 				     void *data, uint16_t peer_id,
 				     uint32_t status)
+{
+	/* handle rx mpdus */
+	qdf_nbuf_t skb = (qdf_nbuf_t)data;
+	struct wlan_lite_mon_batch *batch = (struct wlan_lite_mon_batch *)ctx;
+
+	if (!skb)
+		return;
+
+	qdf_atomic_inc(&batch->in_flight);
+	wlan_lite_mon_rx_deliver(batch->pdev_obj, batch, skb);
+	qdf_atomic_dec(&batch->in_flight);
+}
+
+/**
+ * wlan_lite_mon_rx_process_unbatched - unbatched rx lite mon wdi event
+ * handler, used when the rx batch could not be allocated
+ * @ctx: pdev object
+ * @event: WDI_EVENT_LITE_MON_RX
+ * @data: nbuf
+ * @peer_id: peer id
+ * @status: status
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_rx_process_unbatched(void *ctx, enum WDI_EVENT event,
+					       void *data, uint16_t peer_id,
+					       uint32_t status)
+{
+	qdf_nbuf_t skb = (qdf_nbuf_t)data;
+
+	if (!skb)
+		return;
+
+	wlan_lite_mon_rx_deliver((struct wlan_objmgr_pdev *)ctx, NULL, skb);
+}
+
+/**
+ * wlan_lite_mon_tx_deliver - deliver a lite mon tx capture frame
+ * @pdev_obj: pdev object
+ * @batch: lite mon tx batch, NULL for unbatched delivery
+ * @ptr_tx_info: tx indication info
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_tx_deliver(struct wlan_objmgr_pdev *pdev_obj,
+				     struct wlan_lite_mon_batch *batch,
+				     struct cdp_tx_indication_info *ptr_tx_info)
 {
 	qdf_nbuf_t skb = NULL;
-	struct wlan_objmgr_pdev *pdev_obj = (struct wlan_objmgr_pdev *)pdev_hdl;
 	struct ieee80211com *ic;
 	struct ieee80211vap *vap;
-	osif_dev  *osifp = NULL;
-	struct cdp_tx_indication_info *ptr_tx_info;
-
-	ptr_tx_info = (struct cdp_tx_indication_info *)data;
 
 	if (!ptr_tx_info->mpdu_nbuf)
 		return;
 
+	dp_mon_info("ppdu_id[%d] frm_type[%d] [%p]sending to stack!!!!",
+		  ptr_tx_info->mpdu_info.ppdu_id,
+		  ptr_tx_info->mpdu_info.frame_type,
+		  ptr_tx_info->mpdu_nbuf);
+
+	skb = ptr_tx_info->mpdu_nbuf;
+	ptr_tx_info->mpdu_nbuf = NULL;
+
 	/* If vap is configured, deliver to that vap, else deliver to monitor
 	 * vap. If vap is not configured and monitor vap is also not present,
-	 * then free the skb
+	 * then free the skb. Only frames for the monitor vap are batched as
+	 * that is the one vap which can be looked up again at flush time.
 	 */
 	if (ptr_tx_info->osif_vdev) {
-		osifp = (osif_dev *)ptr_tx_info->osif_vdev;
-	} else {
-		ic = wlan_pdev_get_mlme_ext_obj(pdev_obj);
-		if (!ic) {
-			qdf_nbuf_free(ptr_tx_info->mpdu_nbuf);
-			ptr_tx_info->mpdu_nbuf = NULL;
-			dp_mon_err("ic is NULL");
-			return;
-		}
-		vap = (struct ieee80211vap *)ic->ic_mon_vap;
-		if (vap)
-			osifp = (osif_dev *)vap->iv_ifp;
+		monitor_osif_deliver_tx_capture_data(
+				(osif_dev *)ptr_tx_info->osif_vdev, skb);
+		return;
 	}
 
-	if (!osifp) {
-		qdf_nbuf_free(ptr_tx_info->mpdu_nbuf);
-		ptr_tx_info->mpdu_nbuf = NULL;
+	ic = wlan_pdev_get_mlme_ext_obj(pdev_obj);
+	if (!ic) {
+		qdf_nbuf_free(skb);
+		wlan_lite_mon_batch_drop(batch);
+		dp_mon_err("ic is NULL");
+		return;
+	}
+
+	vap = ic->ic_mon_vap;
+	if (!vap) {
+		qdf_nbuf_free(skb);
+		wlan_lite_mon_batch_drop(batch);
 		dp_mon_debug("No vap to deliver data");
 		return;
 	}
 
-	dp_mon_info("ppdu_id[%d] frm_type[%d] [%p]sending to stack!!!!",
-		  ptr_tx_info->mpdu_info.ppdu_id,
-		  ptr_tx_info->mpdu_info.frame_type,
-		  ptr_tx_info->mpdu_nbuf);
+	if (batch)
+		wlan_lite_mon_batch_add(batch, skb);
+	else
+		monitor_osif_deliver_tx_capture_data((osif_dev *)vap->iv_ifp,
+						     skb);
+}
 
-	skb = ptr_tx_info->mpdu_nbuf;
-	ptr_tx_info->mpdu_nbuf = NULL;
-	monitor_osif_deliver_tx_capture_data(osifp, skb);
+/**
+ * wlan_lite_mon_tx_process - batched tx lite mon wdi event handler
+ * @ctx: lite mon tx batch
+ * @event: WDI_EVENT_LITE_MON_TX
+ * @data: tx indication info
+ * @peer_id: peer id
+ * @status: status
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_tx_process(void *ctx, enum WDI_EVENT event,
+				     void *data, uint16_t peer_id,
+				     uint32_t status)
+{
+	struct wlan_lite_mon_batch *batch = (struct wlan_lite_mon_batch *)ctx;
+
+	qdf_atomic_inc(&batch->in_flight);
+	wlan_lite_mon_tx_deliver(batch->pdev_obj, batch,
+				 (struct cdp_tx_indication_info *)data);
+	qdf_atomic_dec(&batch->in_flight);
+}
+
+/**
+ * wlan_lite_mon_tx_process_unbatched - unbatched tx lite mon wdi event
+ * handler, used when the tx batch could not be allocated
+ * @ctx: pdev object
+ * @event: WDI_EVENT_LITE_MON_TX
+ * @data: tx indication info
+ * @peer_id: peer id
+ * @status: status
+ *
+ * Return: void
+ */
+static void wlan_lite_mon_tx_process_unbatched(void *ctx, enum WDI_EVENT event,
+					       void *data, uint16_t peer_id,
+					       uint32_t status)
+{
+	wlan_lite_mon_tx_deliver((struct wlan_objmgr_pdev *)ctx, NULL,
+				 (struct cdp_tx_indication_info *)data);
 }
 
 /**
  * wlan_lite_mon_rx_subscribe - subscribe for lite mon rx wdi event
  * @scn: scn hdl
  *
+ * Frames are delivered one at a time if the rx batch cannot be allocated.
+ *
  * Return: void
  */
 void wlan_lite_mon_rx_subscribe(struct ol_ath_softc_net80211 *scn)
 {
 	ol_txrx_soc_handle soc_txrx_handle =
 			wlan_psoc_get_dp_handle(scn->soc->psoc_obj);
+	struct wlan_lite_mon_batch *batch;
+
+	batch = wlan_lite_mon_batch_create(scn->sc_pdev, false);
+	if (batch) {
+		scn->lite_mon_rx_subscriber.callback = wlan_lite_mon_rx_process;
+		scn->lite_mon_rx_subscriber.context = batch;
+	} else {
+		scn->lite_mon_rx_subscriber.callback =
+					wlan_lite_mon_rx_process_unbatched;
+		scn->lite_mon_rx_subscriber.context = scn->sc_pdev;
+	}
 
-	scn->lite_mon_rx_subscriber.callback = wlan_lite_mon_rx_process;
-	scn->lite_mon_rx_subscriber.context = scn->sc_pdev;
 	cdp_wdi_event_sub(soc_txrx_handle,
 			  wlan_objmgr_pdev_get_pdev_id(scn->sc_pdev),
 			  &scn->lite_mon_rx_subscriber,
@@ -159,21 +547,38 @@ void wlan_lite_mon_rx_unsubscribe(struct ol_ath_softc_net80211 *scn)
 			    wlan_objmgr_pdev_get_pdev_id(scn->sc_pdev),
 			    &scn->lite_mon_rx_subscriber,
 			    WDI_EVENT_LITE_MON_RX);
+
+	if (scn->lite_mon_rx_subscriber.callback == wlan_lite_mon_rx_process &&
+	    scn->lite_mon_rx_subscriber.context)
+		wlan_lite_mon_batch_destroy(scn->lite_mon_rx_subscriber.context);
+
+	scn->lite_mon_rx_subscriber.context = NULL;
 }
 
 /**
  * wlan_lite_mon_tx_subscribe - subscribe for lite mon tx wdi event
  * @scn: scn hdl
  *
+ * Frames are delivered one at a time if the tx batch cannot be allocated.
+ *
  * Return: void
  */
 void wlan_lite_mon_tx_subscribe(struct ol_ath_softc_net80211 *scn)
 {
 	ol_txrx_soc_handle soc_txrx_handle =
 			wlan_psoc_get_dp_handle(scn->soc->psoc_obj);
+	struct wlan_lite_mon_batch *batch;
+
+	batch = wlan_lite_mon_batch_create(scn->sc_pdev, true);
+	if (batch) {
+		scn->lite_mon_tx_subscriber.callback = wlan_lite_mon_tx_process;
+		scn->lite_mon_tx_subscriber.context = batch;
+	} else {
+		scn->lite_mon_tx_subscriber.callback =
+					wlan_lite_mon_tx_process_unbatched;
+		scn->lite_mon_tx_subscriber.context = scn->sc_pdev;
+	}
 
-	scn->lite_mon_tx_subscriber.callback = wlan_lite_mon_tx_process;
-	scn->lite_mon_tx_subscriber.context = scn->sc_pdev;
 	cdp_wdi_event_sub(soc_txrx_handle,
 			  wlan_objmgr_pdev_get_pdev_id(scn->sc_pdev),
 			  &scn->lite_mon_tx_subscriber,
@@ -195,5 +600,46 @@ void wlan_lite_mon_tx_unsubscribe(struct ol_ath_softc_net80211 *scn)
 			    wlan_objmgr_pdev_get_pdev_id(scn->sc_pdev),
 			    &scn->lite_mon_tx_subscriber,
 			    WDI_EVENT_LITE_MON_TX);
+
+	if (scn->lite_mon_tx_subscriber.callback == wlan_lite_mon_tx_process &&
+	    scn->lite_mon_tx_subscriber.context)
+		wlan_lite_mon_batch_destroy(scn->lite_mon_tx_subscriber.context);
+
+	scn->lite_mon_tx_subscriber.context = NULL;
+}
+
+QDF_STATUS
+wlan_lite_mon_set_batch_params(struct ol_ath_softc_net80211 *scn,
+			       uint32_t thresh, uint32_t timeout_ms)
+{
+	if (!thresh || thresh > LITE_MON_BATCH_THRESH_MAX ||
+	    !timeout_ms || timeout_ms > LITE_MON_BATCH_TIMEOUT_MS_MAX) {
+		dp_mon_err("invalid lite mon batch thresh %u timeout %u ms",
+			   thresh, timeout_ms);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	lite_mon_batch_thresh = thresh;
+	lite_mon_batch_timeout_ms = timeout_ms;
+
+	if (scn->lite_mon_rx_subscriber.callback == wlan_lite_mon_rx_process &&
+	    scn->lite_mon_rx_subscriber.context)
+		wlan_lite_mon_batch_set_params(
+				scn->lite_mon_rx_subscriber.context,
+				thresh, timeout_ms);
+
+	if (scn->lite_mon_tx_subscriber.callback == wlan_lite_mon_tx_process &&
+	    scn->lite_mon_tx_subscriber.context)
+		wlan_lite_mon_batch_set_params(
+				scn->lite_mon_tx_subscriber.context,
+				thresh, timeout_ms);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void wlan_lite_mon_get_batch_params(uint32_t *thresh, uint32_t *timeout_ms)
+{
+	*thresh = lite_mon_batch_thresh;
+	*timeout_ms = lite_mon_batch_timeout_ms;
 }
 #endif
@@ -21,6 +21,20 @@
 #include "qal_vbus_dev.h"
 #include "qal_bridge.h"
 
+/*
+ * Bridge fdb walk. Newer kernels keep every fdb entry on a single
+ * fdb_list instead of hash buckets, so it is walked exactly once.
+ */
+#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 24)
+#define qca_multi_link_tbl_for_each_fdb(_fdb, _br, _i) \
+	for ((_i) = 0; (_i) < BR_HASH_SIZE; (_i)++) \
+		hlist_for_each_entry_rcu(_fdb, &(_br)->hash[_i], hlist)
+#else
+#define qca_multi_link_tbl_for_each_fdb(_fdb, _br, _i) \
+	for ((_i) = 0; (_i) < 1; (_i)++) \
+		hlist_for_each_entry_rcu(_fdb, &(_br)->fdb_list, fdb_node)
+#endif
+
 int qca_multi_link_tbl_get_eth_entries(struct net_device *net_dev,
 					void *fill_buff, int buff_size)
 {
@@ -47,32 +61,25 @@ int qca_multi_link_tbl_get_eth_entries(struct net_device *net_dev,
 	 * Traverse the bridge hah to get all ethernet interface entries.
 	 */
 	qal_vbus_rcu_read_lock();
-	for (i = 0; i < BR_HASH_SIZE ; i++) {
+	qca_multi_link_tbl_for_each_fdb(search_fdb, p->br, i) {
+		ndev = search_fdb->dst ? search_fdb->dst->dev : NULL;
+		wdev = ndev ? ndev->ieee80211_ptr : NULL;
+		if (!wdev && ndev) {
 #if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 24)
-		hlist_for_each_entry_rcu(search_fdb, &p->br->hash[i], hlist) {
+			memcpy(qfdb->qal_mac_addr,
+			       search_fdb->addr.addr, 6);
 #else
-		hlist_for_each_entry_rcu(search_fdb, &p->br->fdb_list,
-					 fdb_node) {
+			memcpy(qfdb->qal_mac_addr,
+			       search_fdb->key.addr.addr, 6);
 #endif
-			ndev = search_fdb->dst ? search_fdb->dst->dev : NULL;
-			wdev = ndev ? ndev->ieee80211_ptr : NULL;
-			if (!wdev && ndev) {
-#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 24)
-				memcpy(qfdb->qal_mac_addr,
-				       search_fdb->addr.addr, 6);
-#else
-				memcpy(qfdb->qal_mac_addr,
-				       search_fdb->key.addr.addr, 6);
-#endif
-				qfdb->qal_fdb_dev = ndev;
-				qfdb->qal_fdb_is_local =  search_fdb->is_local;
-				num_of_entries++;
-				qfdb += 1;
-				buff_size -= fdb_entry_size;
-				if (buff_size < fdb_entry_size) {
-					qal_vbus_rcu_read_unlock();
-					return num_of_entries;
-				}
+			qfdb->qal_fdb_dev = ndev;
+			qfdb->qal_fdb_is_local =  search_fdb->is_local;
+			num_of_entries++;
+			qfdb += 1;
+			buff_size -= fdb_entry_size;
+			if (buff_size < fdb_entry_size) {
+				qal_vbus_rcu_read_unlock();
+				return num_of_entries;
 			}
 		}
 	}
@@ -86,10 +93,9 @@ qdf_export_symbol(qca_multi_link_tbl_get_eth_entries);
 struct net_device *qca_multi_link_tbl_find_sta_or_ap(struct net_device *net_dev,
 					uint8_t dev_type)
 {
-	struct net_bridge_fdb_entry *search_fdb = NULL;
+	struct net_bridge_port *search_port = NULL;
 	struct net_device *search_dev = NULL;
 	struct wireless_dev	*ieee80211_ptr = NULL;
-	int i;
 	enum nl80211_iftype search_if_type;
 	struct net_bridge_port *p = br_port_get_rcu(net_dev);
 
@@ -101,30 +107,23 @@ struct net_device *qca_multi_link_tbl_find_sta_or_ap(struct net_device *net_dev,
 	else
 		search_if_type = NL80211_IFTYPE_STATION;
 
+	/*
+	 * Local fdb entries are the addresses of the bridge ports, so walk
+	 * the port list rather than the whole fdb. This is called per frame
+	 * on the secondary station rx path.
+	 */
 	qal_vbus_rcu_read_lock();
-	for (i = 0; i < BR_HASH_SIZE; i++) {
-#if LINUX_VERSION_CODE < KERNEL_VERSION(5, 4, 24)
-		hlist_for_each_entry_rcu(search_fdb, &p->br->hash[i], hlist) {
-#else
-		hlist_for_each_entry_rcu(search_fdb, &p->br->fdb_list,
-					 fdb_node) {
-#endif
-			if (!search_fdb->is_local)
-				continue;
+	list_for_each_entry_rcu(search_port, &p->br->port_list, list) {
+		search_dev = search_port->dev;
+		if (!search_dev)
+			continue;
 
-			if ((!search_fdb->dst) || (!search_fdb->dst->dev)) {
-				qal_vbus_rcu_read_unlock();
-				return NULL;
-			}
-
-			search_dev = search_fdb->dst->dev;
-			ieee80211_ptr = search_dev->ieee80211_ptr;
-			if (ieee80211_ptr
+		ieee80211_ptr = search_dev->ieee80211_ptr;
+		if (ieee80211_ptr
 		&& (ieee80211_ptr->iftype == search_if_type)
 		&& (ieee80211_ptr->wiphy == net_dev->ieee80211_ptr->wiphy)) {
-				qal_vbus_rcu_read_unlock();
-				return search_dev;
-			}
+			qal_vbus_rcu_read_unlock();
+			return search_dev;
 		}
 	}
 
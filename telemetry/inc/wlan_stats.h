@@ -189,6 +189,75 @@ QDF_STATUS wlan_stats_get_psoc_stats(struct wlan_objmgr_psoc *psoc,
 				     struct stats_config *cfg,
 				     struct unified_stats *stats);
 
+/**
+ * typedef wlan_stats_peer_cb: Per peer callback for bulk peer stats
+ * @peer_mac:  Pointer to Peer mac
+ * @stats:  Pointer to unified stats collected for the peer
+ * @ctx:  Caller context
+ *
+ * The stats are only valid for the duration of the callback.
+ *
+ * Return: QDF_STATUS_SUCCESS to continue, any other value to stop
+ */
+typedef QDF_STATUS (*wlan_stats_peer_cb)(uint8_t *peer_mac,
+					 struct unified_stats *stats,
+					 void *ctx);
+
+/**
+ * struct wlan_stats_peer_dump: Per dump session state for bulk peer stats
+ * @mac:  Snapshot of the vdev's peer MACs taken when the dump started
+ * @num:  Number of valid entries in @mac
+ * @next:  Index in @mac of the first peer not yet reported
+ */
+struct wlan_stats_peer_dump {
+	uint8_t (*mac)[QDF_MAC_ADDR_SIZE];
+	uint32_t num;
+	uint32_t next;
+};
+
+/**
+ * wlan_stats_peer_dump_start(): Function to start a bulk peer stats dump
+ * @vdev:  Pointer to Vdev object
+ * @dump:  Dump session state to initialize
+ *
+ * The vdev's station MACs are snapshotted once here, so every callback of
+ * a multipart dump walks the same peer set; peers joining later are left
+ * for the next dump and peers that left are skipped.
+ *
+ * Return: QDF_STATUS_SUCCESS for success and Error code for failure
+ */
+QDF_STATUS wlan_stats_peer_dump_start(struct wlan_objmgr_vdev *vdev,
+				      struct wlan_stats_peer_dump *dump);
+
+/**
+ * wlan_stats_peer_dump_end(): Function to release a bulk peer stats dump
+ * @dump:  Dump session state set up by wlan_stats_peer_dump_start()
+ *
+ * Return: None
+ */
+void wlan_stats_peer_dump_end(struct wlan_stats_peer_dump *dump);
+
+/**
+ * wlan_stats_get_vdev_peers_stats(): Function to get stats of the peers
+ *                                    of a dump session
+ * @vdev:  Pointer to Vdev object
+ * @cfg:  Pointer to stats config came as part of user request
+ * @dump:  Dump session state, resumed from and updated to the first peer
+ *         not yet reported
+ * @cb:  Callback invoked with each peer's stats
+ * @cb_ctx:  Context passed to @cb
+ *
+ * This lets the netlink handler stream every station of a vdev in a
+ * single dump instead of one request/reply per station.
+ *
+ * Return: QDF_STATUS_SUCCESS when all peers were reported, the value
+ * returned by @cb if it stopped the walk, or error code for failure
+ */
+QDF_STATUS wlan_stats_get_vdev_peers_stats(struct wlan_objmgr_vdev *vdev,
+					   struct stats_config *cfg,
+					   struct wlan_stats_peer_dump *dump,
+					   wlan_stats_peer_cb cb, void *cb_ctx);
+
 /**
  * wlan_stats_is_recursive_valid(): Function to check recursiveness
  * @cfg:  Pointer to stats config came as part of user request
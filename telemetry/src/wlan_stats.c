@@ -33,6 +33,46 @@
 #include <ieee80211_cfg80211.h>
 #include <wlan_stats.h>
 
+/**
+ * union stats_scratch: Largest CDP stats blocks fetched per request
+ *
+ * Each request fetches one of these, copies the requested subset into
+ * the unified stats and discards it. A single preallocated copy is
+ * handed out to the first user, concurrent users fall back to the heap.
+ */
+union stats_scratch {
+	struct cdp_peer_stats peer;
+	struct cdp_vdev_stats vdev;
+	struct cdp_pdev_stats pdev;
+	struct cdp_soc_stats soc;
+};
+
+#define STATS_SCRATCH_BUSY 0
+
+static union stats_scratch g_stats_scratch;
+static unsigned long g_stats_scratch_flags;
+
+static void *stats_scratch_get(size_t size)
+{
+	if (size <= sizeof(g_stats_scratch) &&
+	    !qdf_atomic_test_and_set_bit(STATS_SCRATCH_BUSY,
+					 &g_stats_scratch_flags)) {
+		qdf_mem_zero(&g_stats_scratch, size);
+		return &g_stats_scratch;
+	}
+
+	return qdf_mem_malloc(size);
+}
+
+static void stats_scratch_put(void *buf)
+{
+	if (buf == (void *)&g_stats_scratch)
+		qdf_atomic_clear_bit(STATS_SCRATCH_BUSY,
+				     &g_stats_scratch_flags);
+	else if (buf)
+		qdf_mem_free(buf);
+}
+
 static void fill_basic_data_tx_stats(struct basic_data_tx_stats *tx,
 				     struct cdp_tx_stats *cdp_tx)
 {
@@ -690,7 +730,7 @@ static QDF_STATUS get_basic_peer_data(struct wlan_objmgr_psoc *psoc,
 	uint8_t vdev_id = 0;
 	bool stats_collected = false;
 
-	peer_stats = qdf_mem_malloc(sizeof(struct cdp_peer_stats));
+	peer_stats = stats_scratch_get(sizeof(struct cdp_peer_stats));
 	if (!peer_stats) {
 		qdf_err("Failed allocation!");
 		return QDF_STATUS_E_NOMEM;
@@ -732,7 +772,7 @@ static QDF_STATUS get_basic_peer_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(peer_stats);
+	stats_scratch_put(peer_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -817,7 +857,7 @@ static QDF_STATUS get_basic_vdev_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid psoc or vdev!");
 		return QDF_STATUS_E_INVAL;
 	}
-	vdev_stats = qdf_mem_malloc(sizeof(struct cdp_vdev_stats));
+	vdev_stats = stats_scratch_get(sizeof(struct cdp_vdev_stats));
 	if (!vdev_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -845,7 +885,7 @@ static QDF_STATUS get_basic_vdev_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(vdev_stats);
+	stats_scratch_put(vdev_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -1018,7 +1058,7 @@ static QDF_STATUS get_basic_pdev_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid pdev and psoc!");
 		return QDF_STATUS_E_INVAL;
 	}
-	pdev_stats = qdf_mem_malloc(sizeof(struct cdp_pdev_stats));
+	pdev_stats = stats_scratch_get(sizeof(struct cdp_pdev_stats));
 	if (!pdev_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -1046,7 +1086,7 @@ static QDF_STATUS get_basic_pdev_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(pdev_stats);
+	stats_scratch_put(pdev_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -1125,7 +1165,7 @@ static QDF_STATUS get_basic_psoc_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid psoc!");
 		return QDF_STATUS_E_INVAL;
 	}
-	psoc_stats = qdf_mem_malloc(sizeof(struct cdp_soc_stats));
+	psoc_stats = stats_scratch_get(sizeof(struct cdp_soc_stats));
 	if (!psoc_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -1151,7 +1191,7 @@ static QDF_STATUS get_basic_psoc_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(psoc_stats);
+	stats_scratch_put(psoc_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -2000,8 +2040,10 @@ static QDF_STATUS get_advance_peer_data(struct wlan_objmgr_psoc *psoc,
 
 	dp_soc = wlan_psoc_get_dp_handle(psoc);
 	vdev_id = wlan_vdev_get_id(vdev);
-	if (feat & ~(STATS_FEAT_FLG_DELAY | STATS_FEAT_FLG_JITTER)) {
-		peer_stats = qdf_mem_malloc(sizeof(struct cdp_peer_stats));
+	/* Delay, jitter and SAWF stats are fetched separately */
+	if (feat & ~(STATS_FEAT_FLG_DELAY | STATS_FEAT_FLG_JITTER |
+		     STATS_FEAT_FLG_SAWFDELAY | STATS_FEAT_FLG_SAWFTX)) {
+		peer_stats = stats_scratch_get(sizeof(struct cdp_peer_stats));
 		if (!peer_stats) {
 			qdf_err("Failed allocation!");
 			return QDF_STATUS_E_NOMEM;
@@ -2119,7 +2161,7 @@ static QDF_STATUS get_advance_peer_data(struct wlan_objmgr_psoc *psoc,
 
 get_failed:
 	if (peer_stats)
-		qdf_mem_free(peer_stats);
+		stats_scratch_put(peer_stats);
 	if (delay)
 		qdf_mem_free(delay);
 	if (jitter)
@@ -2503,7 +2545,7 @@ static QDF_STATUS get_advance_vdev_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid psoc or vdev!");
 		return QDF_STATUS_E_INVAL;
 	}
-	vdev_stats = qdf_mem_malloc(sizeof(struct cdp_vdev_stats));
+	vdev_stats = stats_scratch_get(sizeof(struct cdp_vdev_stats));
 	if (!vdev_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -2573,7 +2615,7 @@ static QDF_STATUS get_advance_vdev_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(vdev_stats);
+	stats_scratch_put(vdev_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -3184,7 +3226,7 @@ static QDF_STATUS get_advance_pdev_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid pdev and psoc!");
 		return QDF_STATUS_E_INVAL;
 	}
-	pdev_stats = qdf_mem_malloc(sizeof(struct cdp_pdev_stats));
+	pdev_stats = stats_scratch_get(sizeof(struct cdp_pdev_stats));
 	if (!pdev_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -3272,7 +3314,7 @@ static QDF_STATUS get_advance_pdev_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(pdev_stats);
+	stats_scratch_put(pdev_stats);
 	if (vow)
 		qdf_mem_free(vow);
 
@@ -3405,7 +3447,7 @@ static QDF_STATUS get_advance_psoc_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid psoc!");
 		return QDF_STATUS_E_INVAL;
 	}
-	psoc_stats = qdf_mem_malloc(sizeof(struct cdp_soc_stats));
+	psoc_stats = stats_scratch_get(sizeof(struct cdp_soc_stats));
 	if (!psoc_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -3431,7 +3473,7 @@ static QDF_STATUS get_advance_psoc_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(psoc_stats);
+	stats_scratch_put(psoc_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -3801,7 +3843,7 @@ static QDF_STATUS get_debug_peer_data(struct wlan_objmgr_psoc *psoc,
 	vdev_id = wlan_vdev_get_id(vdev);
 	dp_soc = wlan_psoc_get_dp_handle(psoc);
 	if (feat & ~STATS_FEAT_FLG_TXCAP) {
-		peer_stats = qdf_mem_malloc(sizeof(struct cdp_peer_stats));
+		peer_stats = stats_scratch_get(sizeof(struct cdp_peer_stats));
 		if (!peer_stats) {
 			qdf_err("Failed allocation!");
 			return QDF_STATUS_E_NOMEM;
@@ -3860,7 +3902,7 @@ get_failed:
 	if (cap)
 		qdf_mem_free(cap);
 	if (peer_stats)
-		qdf_mem_free(peer_stats);
+		stats_scratch_put(peer_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -4192,7 +4234,7 @@ static QDF_STATUS get_debug_vdev_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid psoc or vdev!");
 		return QDF_STATUS_E_INVAL;
 	}
-	vdev_stats = qdf_mem_malloc(sizeof(struct cdp_vdev_stats));
+	vdev_stats = stats_scratch_get(sizeof(struct cdp_vdev_stats));
 	if (!vdev_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -4241,7 +4283,7 @@ static QDF_STATUS get_debug_vdev_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(vdev_stats);
+	stats_scratch_put(vdev_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -4975,7 +5017,7 @@ static QDF_STATUS get_debug_pdev_data(struct wlan_objmgr_psoc *psoc,
 		return QDF_STATUS_E_INVAL;
 	}
 
-	pdev_stats = qdf_mem_malloc(sizeof(struct cdp_pdev_stats));
+	pdev_stats = stats_scratch_get(sizeof(struct cdp_pdev_stats));
 	if (!pdev_stats) {
 		qdf_err("Allocation Failed!");
 		return QDF_STATUS_E_NOMEM;
@@ -5080,7 +5122,7 @@ get_failed:
 		qdf_mem_free(cap);
 	if (mon)
 		qdf_mem_free(mon);
-	qdf_mem_free(pdev_stats);
+	stats_scratch_put(pdev_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -5348,7 +5390,7 @@ static QDF_STATUS get_debug_psoc_data(struct wlan_objmgr_psoc *psoc,
 		qdf_err("Invalid psoc!");
 		return QDF_STATUS_E_INVAL;
 	}
-	psoc_stats = qdf_mem_malloc(sizeof(struct cdp_soc_stats));
+	psoc_stats = stats_scratch_get(sizeof(struct cdp_soc_stats));
 	if (!psoc_stats) {
 		qdf_err("Allocation failed");
 		return QDF_STATUS_E_NOMEM;
@@ -5382,7 +5424,7 @@ static QDF_STATUS get_debug_psoc_data(struct wlan_objmgr_psoc *psoc,
 	}
 
 get_failed:
-	qdf_mem_free(psoc_stats);
+	stats_scratch_put(psoc_stats);
 	if (stats_collected)
 		ret = QDF_STATUS_SUCCESS;
 
@@ -5554,6 +5596,99 @@ QDF_STATUS wlan_stats_get_psoc_stats(struct wlan_objmgr_psoc *psoc,
 	return ret;
 }
 
+/**
+ * struct peer_mac_list: Snapshot of peer MACs taken under vdev iteration
+ * @dump: Dump session the MACs are collected into
+ * @max: Capacity of the dump's MAC array in entries
+ */
+struct peer_mac_list {
+	struct wlan_stats_peer_dump *dump;
+	uint32_t max;
+};
+
+static void collect_peer_mac(struct wlan_objmgr_vdev *vdev,
+			     void *object, void *arg)
+{
+	struct wlan_objmgr_peer *peer = object;
+	struct peer_mac_list *list = arg;
+	struct wlan_stats_peer_dump *dump;
+
+	if (!peer || !list)
+		return;
+	dump = list->dump;
+	if (dump->num >= list->max)
+		return;
+	if (wlan_peer_get_peer_type(peer) != WLAN_PEER_STA)
+		return;
+
+	qdf_mem_copy(dump->mac[dump->num++], wlan_peer_get_macaddr(peer),
+		     QDF_MAC_ADDR_SIZE);
+}
+
+QDF_STATUS wlan_stats_peer_dump_start(struct wlan_objmgr_vdev *vdev,
+				      struct wlan_stats_peer_dump *dump)
+{
+	struct peer_mac_list list = {0};
+
+	if (!vdev || !dump)
+		return QDF_STATUS_E_INVAL;
+
+	qdf_mem_zero(dump, sizeof(*dump));
+	list.dump = dump;
+	list.max = wlan_vdev_get_peer_count(vdev);
+	if (!list.max)
+		return QDF_STATUS_SUCCESS;
+
+	dump->mac = qdf_mem_malloc(list.max * QDF_MAC_ADDR_SIZE);
+	if (!dump->mac) {
+		qdf_err("Allocation Failed!");
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	/**
+	 * Peer stats collection may block on control path stats, so only
+	 * the MACs are gathered under the vdev peer list iteration.
+	 **/
+	wlan_objmgr_iterate_peerobj_list(vdev, collect_peer_mac, &list,
+					 WLAN_MLME_SB_ID);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void wlan_stats_peer_dump_end(struct wlan_stats_peer_dump *dump)
+{
+	if (!dump)
+		return;
+
+	qdf_mem_free(dump->mac);
+	qdf_mem_zero(dump, sizeof(*dump));
+}
+
+QDF_STATUS wlan_stats_get_vdev_peers_stats(struct wlan_objmgr_vdev *vdev,
+					   struct stats_config *cfg,
+					   struct wlan_stats_peer_dump *dump,
+					   wlan_stats_peer_cb cb, void *cb_ctx)
+{
+	struct unified_stats stats;
+	QDF_STATUS ret = QDF_STATUS_SUCCESS;
+
+	if (!vdev || !cfg || !dump || !cb)
+		return QDF_STATUS_E_INVAL;
+
+	for (; dump->next < dump->num; dump->next++) {
+		qdf_mem_zero(&stats, sizeof(stats));
+		/* Peers that left since the snapshot fail here and are skipped */
+		if (wlan_stats_get_peer_stats(vdev, dump->mac[dump->next], cfg,
+					      &stats) == QDF_STATUS_SUCCESS)
+			ret = cb(dump->mac[dump->next], &stats, cb_ctx);
+		wlan_stats_free_unified_stats(&stats);
+		if (ret != QDF_STATUS_SUCCESS)
+			break;
+	}
+
+	return ret;
+}
+
 void wlan_stats_free_unified_stats(struct unified_stats *stats)
 {
 	u_int8_t inx = 0;
@@ -1396,6 +1396,10 @@ enum _ol_ath_param_t {
 	OL_ATH_PARAM_GET_MONITOR_VERSION = 513,
 	OL_ATH_PARAM_DFS_BW_EXPAND = 514,
 	OL_ATH_PARAM_BCN_MAX_COUNT = 515,
+	/* Lite monitor batched delivery threshold (frames) */
+	OL_ATH_PARAM_LITE_MON_BATCH_THRESH = 516,
+	/* Lite monitor batched delivery timeout (ms) */
+	OL_ATH_PARAM_LITE_MON_BATCH_TIMEOUT = 517,
 };
 
 #ifdef CONFIG_SUPPORT_VENCMDTABLE
@@ -3685,6 +3689,14 @@ struct vendor_commands radio_vendor_cmds[] = {
 		OL_ATH_PARAM_SHIFT | OL_ATH_PARAM_BCN_MAX_COUNT, SET_PARAM, 1},
 	{"g_max_bcn_cnt",
 		OL_ATH_PARAM_SHIFT | OL_ATH_PARAM_BCN_MAX_COUNT, GET_PARAM, 0},
+	{"lite_mon_batch_thresh",
+		OL_ATH_PARAM_SHIFT | OL_ATH_PARAM_LITE_MON_BATCH_THRESH, SET_PARAM, 1},
+	{"g_lite_mon_batch_thresh",
+		OL_ATH_PARAM_SHIFT | OL_ATH_PARAM_LITE_MON_BATCH_THRESH, GET_PARAM, 0},
+	{"lite_mon_batch_timeout",
+		OL_ATH_PARAM_SHIFT | OL_ATH_PARAM_LITE_MON_BATCH_TIMEOUT, SET_PARAM, 1},
+	{"g_lite_mon_batch_timeout",
+		OL_ATH_PARAM_SHIFT | OL_ATH_PARAM_LITE_MON_BATCH_TIMEOUT, GET_PARAM, 0},
 };
 #endif
 
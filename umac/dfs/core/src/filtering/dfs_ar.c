@@ -52,7 +52,8 @@ void dfs_process_ar_event(struct wlan_dfs *dfs,
 	uint32_t rssi = 0, width = 0;
 	uint32_t origregionsum = 0, i = 0;
 	uint16_t thistimestamp;
-	int empty;
+	STAILQ_HEAD(, dfs_event) arq;
+	STAILQ_HEAD(, dfs_event) freeq;
 
 	if (!dfs) {
 		dfs_err(dfs, WLAN_DEBUG_DFS_ALWAYS,  "dfs is NULL");
@@ -60,27 +61,30 @@ void dfs_process_ar_event(struct wlan_dfs *dfs,
 	}
 
 	ar = (struct dfs_ar_state *) &(dfs->dfs_ar_state);
+	STAILQ_INIT(&arq);
+	STAILQ_INIT(&freeq);
+
+	/*
+	 * Detach all queued events under a single ARQ lock and process them
+	 * unlocked; events queued meanwhile are handled on the next call.
+	 */
 	WLAN_ARQ_LOCK(dfs);
-	empty = STAILQ_EMPTY(&(dfs->dfs_arq));
+	STAILQ_CONCAT(&arq, &(dfs->dfs_arq));
 	WLAN_ARQ_UNLOCK(dfs);
-	while (!empty) {
-		WLAN_ARQ_LOCK(dfs);
-		re = STAILQ_FIRST(&(dfs->dfs_arq));
-		if (re != NULL)
-			STAILQ_REMOVE_HEAD(&(dfs->dfs_arq), re_list);
-		WLAN_ARQ_UNLOCK(dfs);
-		if (!re)
-			return;
+
+	while ((re = STAILQ_FIRST(&arq))) {
+		STAILQ_REMOVE_HEAD(&arq, re_list);
 
 		thistimestamp = re->re_ts;
 		rssi = re->re_rssi;
 		width = re->re_dur;
 
-		/* Return the dfs event to the free event list. */
+		/*
+		 * Collect the dfs event for return to the free event list
+		 * once the batch is done.
+		 */
 		qdf_mem_zero(re, sizeof(struct dfs_event));
-		WLAN_DFSEVENTQ_LOCK(dfs);
-		STAILQ_INSERT_TAIL(&(dfs->dfs_eventq), re, re_list);
-		WLAN_DFSEVENTQ_UNLOCK(dfs);
+		STAILQ_INSERT_TAIL(&freeq, re, re_list);
 
 		/*
 		 * Determine if current radar is an extension of previous
@@ -139,12 +143,8 @@ void dfs_process_ar_event(struct wlan_dfs *dfs,
 				    ar->ar_prevtimestamp) != (width - base))
 				width = 1;
 		}
-		if (width <= 10) {
-			WLAN_ARQ_LOCK(dfs);
-			empty = STAILQ_EMPTY(&(dfs->dfs_arq));
-			WLAN_ARQ_UNLOCK(dfs);
+		if (width <= 10)
 			continue;
-		}
 
 		/*
 		 * Overloading the width=2 in: Store a count of
@@ -170,9 +170,6 @@ void dfs_process_ar_event(struct wlan_dfs *dfs,
 			ar->ar_phyerrcount[width]++;
 		else {
 			/* Invalid radar width, throw it away. */
-			WLAN_ARQ_LOCK(dfs);
-			empty = STAILQ_EMPTY(&(dfs->dfs_arq));
-			WLAN_ARQ_UNLOCK(dfs);
 			continue;
 		}
 
@@ -276,10 +273,12 @@ void dfs_process_ar_event(struct wlan_dfs *dfs,
 			}
 		}
 		ar->ar_prevtimestamp = thistimestamp;
-		WLAN_ARQ_LOCK(dfs);
-		empty = STAILQ_EMPTY(&(dfs->dfs_arq));
-		WLAN_ARQ_UNLOCK(dfs);
 	}
+
+	/* Return the processed events to the free event list. */
+	WLAN_DFSEVENTQ_LOCK(dfs);
+	STAILQ_CONCAT(&(dfs->dfs_eventq), &freeq);
+	WLAN_DFSEVENTQ_UNLOCK(dfs);
 }
 
 void dfs_reset_ar(struct wlan_dfs *dfs)
@@ -33,6 +33,26 @@
 #include <wlan_reg_channel_api.h>
 #include <wlan_reg_services_api.h>
 
+struct regulatory_channel *
+reg_get_cur_chan_for_freq(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq)
+{
+	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
+	enum channel_enum chan_enum;
+
+	chan_enum = reg_get_chan_enum_for_freq(freq);
+	if (chan_enum == INVALID_CHANNEL)
+		return NULL;
+
+	pdev_priv_obj = reg_get_pdev_obj(pdev);
+
+	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj)) {
+		reg_err("reg pdev priv obj is NULL");
+		return NULL;
+	}
+
+	return &pdev_priv_obj->cur_chan_list[chan_enum];
+}
+
 #ifdef CONFIG_HOST_FIND_CHAN
 
 #ifdef WLAN_FEATURE_11BE
@@ -334,47 +354,24 @@ bool reg_is_phymode_chwidth_allowed(
 
 void reg_set_chan_blocked(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq)
 {
-	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
-	struct regulatory_channel *cur_chan_list;
-	int i;
-
-	pdev_priv_obj = reg_get_pdev_obj(pdev);
+	struct regulatory_channel *chan;
 
-	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj)) {
-		reg_err("reg pdev priv obj is NULL");
+	chan = reg_get_cur_chan_for_freq(pdev, freq);
+	if (!chan)
 		return;
-	}
-
-	cur_chan_list = pdev_priv_obj->cur_chan_list;
 
-	for (i = 0; i < NUM_CHANNELS; i++) {
-		if (cur_chan_list[i].center_freq == freq) {
-			cur_chan_list[i].is_chan_hop_blocked = true;
-			break;
-		}
-	}
+	chan->is_chan_hop_blocked = true;
 }
 
 bool reg_is_chan_blocked(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq)
 {
-	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
-	struct regulatory_channel *cur_chan_list;
-	int i;
-
-	pdev_priv_obj = reg_get_pdev_obj(pdev);
+	struct regulatory_channel *chan;
 
-	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj)) {
-		reg_err("reg pdev priv obj is NULL");
+	chan = reg_get_cur_chan_for_freq(pdev, freq);
+	if (!chan)
 		return false;
-	}
 
-	cur_chan_list = pdev_priv_obj->cur_chan_list;
-
-	for (i = 0; i < NUM_CHANNELS; i++)
-		if (cur_chan_list[i].center_freq == freq)
-			return cur_chan_list[i].is_chan_hop_blocked;
-
-	return false;
+	return chan->is_chan_hop_blocked;
 }
 
 void reg_clear_allchan_blocked(struct wlan_objmgr_pdev *pdev)
@@ -399,71 +396,37 @@ void reg_clear_allchan_blocked(struct wlan_objmgr_pdev *pdev)
 void reg_set_chan_ht40intol(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq,
 			    enum ht40_intol ht40intol_flags)
 {
-	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
-	struct regulatory_channel *cur_chan_list;
-	int i;
-
-	pdev_priv_obj = reg_get_pdev_obj(pdev);
+	struct regulatory_channel *chan;
 
-	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj)) {
-		reg_err("reg pdev priv obj is NULL");
+	chan = reg_get_cur_chan_for_freq(pdev, freq);
+	if (!chan)
 		return;
-	}
-
-	cur_chan_list = pdev_priv_obj->cur_chan_list;
 
-	for (i = 0; i < NUM_CHANNELS; i++) {
-		if (cur_chan_list[i].center_freq == freq)
-			cur_chan_list[i].ht40intol_flags |=
-					BIT(ht40intol_flags);
-	}
+	chan->ht40intol_flags |= BIT(ht40intol_flags);
 }
 
 void reg_clear_chan_ht40intol(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq,
 			      enum ht40_intol ht40intol_flags)
 {
-	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
-	struct regulatory_channel *cur_chan_list;
-	int i;
-
-	pdev_priv_obj = reg_get_pdev_obj(pdev);
+	struct regulatory_channel *chan;
 
-	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj)) {
-		reg_err("reg pdev priv obj is NULL");
+	chan = reg_get_cur_chan_for_freq(pdev, freq);
+	if (!chan)
 		return;
-	}
-
-	cur_chan_list = pdev_priv_obj->cur_chan_list;
 
-	for (i = 0; i < NUM_CHANNELS; i++) {
-		if (cur_chan_list[i].center_freq == freq)
-			cur_chan_list[i].ht40intol_flags &=
-				~(BIT(ht40intol_flags));
-	}
+	chan->ht40intol_flags &= ~(BIT(ht40intol_flags));
 }
 
 bool reg_is_chan_ht40intol(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq,
 			   enum ht40_intol ht40intol_flags)
 {
-	struct wlan_regulatory_pdev_priv_obj *pdev_priv_obj;
-	struct regulatory_channel *cur_chan_list;
-	int i;
-
-	pdev_priv_obj = reg_get_pdev_obj(pdev);
+	struct regulatory_channel *chan;
 
-	if (!IS_VALID_PDEV_REG_OBJ(pdev_priv_obj)) {
-		reg_err("reg pdev priv obj is NULL");
+	chan = reg_get_cur_chan_for_freq(pdev, freq);
+	if (!chan)
 		return false;
-	}
-
-	cur_chan_list = pdev_priv_obj->cur_chan_list;
 
-	for (i = 0; i < NUM_CHANNELS; i++)
-		if (cur_chan_list[i].center_freq == freq)
-			return (cur_chan_list[i].ht40intol_flags &
-				BIT(ht40intol_flags));
-
-	return false;
+	return (chan->ht40intol_flags & BIT(ht40intol_flags));
 }
 
 void reg_clear_allchan_ht40intol(struct wlan_objmgr_pdev *pdev)
@@ -644,27 +607,30 @@ void reg_intersect_chan_list_power(struct wlan_objmgr_pdev *pdev,
 		return;
 	}
 
+	/*
+	 * Both lists follow the channel enum order and so are sorted by
+	 * center frequency; walk them together instead of rescanning the
+	 * secondary list for every primary channel.
+	 */
+	j = 0;
 	for (i = 0; i < chan_list_size; i++) {
 		if ((pri_chan_list[i].state == CHANNEL_STATE_DISABLE) ||
 		    (pri_chan_list[i].chan_flags & REGULATORY_CHAN_DISABLED)) {
 			continue;
 		}
 
-		chan_found_in_sec_list = false;
-		for (j = 0; j < chan_list_size; j++) {
-			if ((sec_chan_list[j].state ==
-						CHANNEL_STATE_DISABLE) ||
-			    (sec_chan_list[j].chan_flags &
-						REGULATORY_CHAN_DISABLED)) {
-				continue;
-			}
+		while ((j < chan_list_size) &&
+		       (sec_chan_list[j].center_freq <
+				pri_chan_list[i].center_freq))
+			j++;
 
-			if (pri_chan_list[i].center_freq ==
-				sec_chan_list[j].center_freq) {
-				chan_found_in_sec_list = true;
-				break;
-			}
-		}
+		chan_found_in_sec_list =
+			(j < chan_list_size) &&
+			(sec_chan_list[j].center_freq ==
+				pri_chan_list[i].center_freq) &&
+			(sec_chan_list[j].state != CHANNEL_STATE_DISABLE) &&
+			!(sec_chan_list[j].chan_flags &
+				REGULATORY_CHAN_DISABLED);
 
 		if (!chan_found_in_sec_list) {
 			pri_chan_list[i].state = CHANNEL_STATE_DISABLE;
@@ -1060,6 +1026,52 @@ reg_remove_320mhz_modes(int max_bw, uint64_t *wireless_modes)
 }
 #endif
 
+/**
+ * reg_get_5g_bw_without_radar() - Get the radar free bandwidth of a 5 GHz
+ * channel, memoised across the power modes of one capability scan
+ * @pdev: Pointer to pdev
+ * @chan_idx: Channel enum of @freq
+ * @freq: Channel center frequency
+ * @cur_bw: Regulatory max bandwidth of the channel
+ * @memo_in_bw: Per 5 GHz channel input bandwidth of the memoised result
+ * @memo_out_bw: Per 5 GHz channel memoised radar free bandwidth
+ *
+ * The 5 GHz part of the channel list does not depend on the 6 GHz power
+ * mode, so the bonded channel walk is done once per channel rather than
+ * once per power mode.
+ *
+ * Return: Radar free bandwidth in MHz.
+ */
+static uint16_t
+reg_get_5g_bw_without_radar(struct wlan_objmgr_pdev *pdev,
+			    enum channel_enum chan_idx,
+			    qdf_freq_t freq,
+			    uint16_t cur_bw,
+			    uint16_t *memo_in_bw,
+			    uint16_t *memo_out_bw)
+{
+	enum phy_ch_width in_chwidth, out_chwidth;
+	uint16_t out_bw;
+	int idx;
+
+	idx = chan_idx - MIN_5GHZ_CHANNEL;
+	if (idx >= 0 && idx < NUM_5GHZ_CHANNELS && cur_bw &&
+	    memo_in_bw[idx] == cur_bw)
+		return memo_out_bw[idx];
+
+	in_chwidth = reg_find_chwidth_from_bw(cur_bw);
+	out_chwidth = reg_get_max_channel_width_without_radar(pdev, freq,
+							      in_chwidth);
+	out_bw = chwd_2_contbw_lst[out_chwidth];
+
+	if (idx >= 0 && idx < NUM_5GHZ_CHANNELS) {
+		memo_in_bw[idx] = cur_bw;
+		memo_out_bw[idx] = out_bw;
+	}
+
+	return out_bw;
+}
+
 uint16_t reg_get_wmodes_and_max_chwidth(struct wlan_objmgr_pdev *pdev,
 					uint64_t *mode_select,
 					bool include_nol_chan)
@@ -1070,6 +1082,8 @@ uint16_t reg_get_wmodes_and_max_chwidth(struct wlan_objmgr_pdev *pdev,
 	enum supported_6g_pwr_types pwr_mode;
 	int i, max_bw = BW_20_MHZ;
 	uint64_t band_modes = 0;
+	uint16_t memo_in_bw[NUM_5GHZ_CHANNELS] = {0};
+	uint16_t memo_out_bw[NUM_5GHZ_CHANNELS];
 
 	pdev_priv_obj = reg_get_pdev_obj(pdev);
 
@@ -1110,17 +1124,12 @@ uint16_t reg_get_wmodes_and_max_chwidth(struct wlan_objmgr_pdev *pdev,
 				band_modes |= WIRELESS_6G_MODES;
 
 			if (!include_nol_chan &&
-			    WLAN_REG_IS_5GHZ_CH_FREQ(freq)) {
-				enum phy_ch_width in_chwidth, out_chwidth;
-
-				in_chwidth = reg_find_chwidth_from_bw(cur_bw);
-				out_chwidth =
-				    reg_get_max_channel_width_without_radar(
-								pdev,
-								freq,
-								in_chwidth);
-				cur_bw = chwd_2_contbw_lst[out_chwidth];
-			}
+			    WLAN_REG_IS_5GHZ_CH_FREQ(freq))
+				cur_bw = reg_get_5g_bw_without_radar(
+								pdev, i, freq,
+								cur_bw,
+								memo_in_bw,
+								memo_out_bw);
 
 			if (max_bw < cur_bw)
 				max_bw = cur_bw;
@@ -29,6 +29,22 @@
 
 #define NEXT_20_CH_OFFSET 20
 
+/**
+ * reg_get_cur_chan_for_freq() - Get the current channel list entry for a
+ * frequency
+ * @pdev: Pointer to pdev.
+ * @freq: Channel frequency in MHz.
+ *
+ * The current channel list is indexed by channel_enum and the enum of a
+ * frequency is fixed by the channel map, so the entry is located directly
+ * instead of scanning the list.
+ *
+ * Return: Pointer to the cur_chan_list entry of @freq, or NULL if @freq is
+ * not a valid channel frequency or the pdev regulatory object is invalid.
+ */
+struct regulatory_channel *
+reg_get_cur_chan_for_freq(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq);
+
 #ifdef CONFIG_HOST_FIND_CHAN
 
 /**
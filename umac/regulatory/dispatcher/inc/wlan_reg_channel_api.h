@@ -303,6 +303,21 @@ bool wlan_reg_is_nol_for_freq(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq);
 bool wlan_reg_is_nol_hist_for_freq(struct wlan_objmgr_pdev *pdev,
 				   qdf_freq_t freq);
 
+/**
+ * wlan_reg_get_cur_chan_for_freq() - Get the regulatory current channel list
+ * entry of a frequency
+ * @pdev: Pointer to pdev.
+ * @freq: Channel frequency in MHz.
+ *
+ * Meant for callers such as DFS and ACS that query channels one frequency at
+ * a time; the entry is looked up by channel_enum rather than by scanning the
+ * channel list.
+ *
+ * Return: Pointer to the channel entry, or NULL if @freq is not valid.
+ */
+struct regulatory_channel *
+wlan_reg_get_cur_chan_for_freq(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq);
+
 /**
  * wlan_reg_get_ap_chan_list() - Get AP channel list
  * @pdev       : Pointer to pdev
@@ -236,6 +236,14 @@ bool wlan_reg_is_nol_hist_for_freq(struct wlan_objmgr_pdev *pdev,
 	return reg_is_nol_hist_for_freq(pdev, freq);
 }
 
+struct regulatory_channel *
+wlan_reg_get_cur_chan_for_freq(struct wlan_objmgr_pdev *pdev, qdf_freq_t freq)
+{
+	return reg_get_cur_chan_for_freq(pdev, freq);
+}
+
+qdf_export_symbol(wlan_reg_get_cur_chan_for_freq);
+
 QDF_STATUS wlan_reg_get_ap_chan_list(struct wlan_objmgr_pdev *pdev,
 				     struct regulatory_channel *chan_list,
 				     bool get_cur_chan_list,
@@ -130,9 +130,11 @@ struct wlan_sawf_scv_class_params {
 /**
  * struct sawf_ctx- SAWF context
  * @svc_classes: List of all service classes
+ * @generation: bumped on every service class change, never 0
  */
 struct sawf_ctx {
 	struct wlan_sawf_scv_class_params svc_classes[SAWF_SVC_CLASS_MAX];
+	uint32_t generation;
 };
 
 /* wlan_sawf_init() - Initialize SAWF subsytem
@@ -204,6 +206,15 @@ bool wlan_delay_bound_configured(uint8_t svc_id);
 struct wlan_sawf_scv_class_params *
 wlan_get_svc_class_params(uint8_t svc_id);
 
+/* wlan_sawf_get_generation() - Get service-class params generation
+ *
+ * Users caching service-class params refresh their copy when the
+ * generation they cached differs from the current one.
+ *
+ * Return: current generation, 0 if SAWF is not initialized
+ */
+uint32_t wlan_sawf_get_generation(void);
+
 /* wlan_print_service_class() - Print service class params
  *
  * Print service class params
@@ -220,6 +231,25 @@ void wlan_print_service_class(struct wlan_sawf_scv_class_params *params);
  */
 void wlan_update_sawf_params(struct wlan_sawf_scv_class_params *params);
 
+/* wlan_sawf_set_svc_class_configured() - Mark service class configured
+ *
+ * Mark a service class configured on create, or unconfigured on disable
+ * @svc_id : service-class id
+ * @configured : service class is configured
+ *
+ * Return: none
+ */
+void wlan_sawf_set_svc_class_configured(uint8_t svc_id, bool configured);
+
+/* wlan_sawf_delete_svc_class() - Delete a service class
+ *
+ * Clear the params of a service class and mark it unconfigured
+ * @svc_id : service-class id
+ *
+ * Return: none
+ */
+void wlan_sawf_delete_svc_class(uint8_t svc_id);
+
 /* wlan_validate_sawf_params() - Validate service class params
  *
  * Validate service class params
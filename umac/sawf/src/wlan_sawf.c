@@ -42,6 +42,8 @@ QDF_STATUS wlan_sawf_init(void)
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	g_wlan_sawf_ctx->generation = 1;
+
 	qdf_info("SAWF: SAWF ctx is initialized");
 	return QDF_STATUS_SUCCESS;
 }
@@ -175,6 +177,33 @@ wlan_get_svc_class_params(uint8_t svc_id)
 }
 qdf_export_symbol(wlan_get_svc_class_params);
 
+/**
+ * wlan_sawf_bump_generation() - Invalidate cached service-class params
+ * @sawf: SAWF context
+ *
+ * Must be called by every path changing the configured state or the
+ * params of a service class. 0 is reserved for "nothing cached".
+ *
+ * Return: none
+ */
+static inline void wlan_sawf_bump_generation(struct sawf_ctx *sawf)
+{
+	if (!++sawf->generation)
+		sawf->generation = 1;
+}
+
+uint32_t wlan_sawf_get_generation(void)
+{
+	struct sawf_ctx *sawf;
+
+	sawf = wlan_get_sawf_ctx();
+	if (!sawf)
+		return 0;
+
+	return sawf->generation;
+}
+qdf_export_symbol(wlan_sawf_get_generation);
+
 void wlan_update_sawf_params(struct wlan_sawf_scv_class_params *params)
 {
 	struct sawf_ctx *sawf;
@@ -197,10 +226,57 @@ void wlan_update_sawf_params(struct wlan_sawf_scv_class_params *params)
 	new_param->priority = params->priority;
 	new_param->tid = params->tid;
 	new_param->msdu_rate_loss = params->msdu_rate_loss;
+
+	wlan_sawf_bump_generation(sawf);
 }
 
 qdf_export_symbol(wlan_update_sawf_params);
 
+void wlan_sawf_set_svc_class_configured(uint8_t svc_id, bool configured)
+{
+	struct sawf_ctx *sawf;
+
+	sawf = wlan_get_sawf_ctx();
+	if (!sawf) {
+		qdf_err("SAWF ctx is invalid");
+		return;
+	}
+
+	if (!wlan_service_id_valid(svc_id)) {
+		qdf_err("Invalid svc-class id");
+		return;
+	}
+
+	sawf->svc_classes[svc_id - 1].configured = configured;
+
+	wlan_sawf_bump_generation(sawf);
+}
+
+qdf_export_symbol(wlan_sawf_set_svc_class_configured);
+
+void wlan_sawf_delete_svc_class(uint8_t svc_id)
+{
+	struct sawf_ctx *sawf;
+
+	sawf = wlan_get_sawf_ctx();
+	if (!sawf) {
+		qdf_err("SAWF ctx is invalid");
+		return;
+	}
+
+	if (!wlan_service_id_valid(svc_id)) {
+		qdf_err("Invalid svc-class id");
+		return;
+	}
+
+	qdf_mem_zero(&sawf->svc_classes[svc_id - 1],
+		     sizeof(struct wlan_sawf_scv_class_params));
+
+	wlan_sawf_bump_generation(sawf);
+}
+
+qdf_export_symbol(wlan_sawf_delete_svc_class);
+
 QDF_STATUS wlan_validate_sawf_params(struct wlan_sawf_scv_class_params *params)
 {
 	uint32_t value;